@@ -231,10 +231,10 @@ QString NodeT::toString(void) const
     result.append(QObject::tr("\nHost: %1"
                               "\nGroups: %2"
                               "\nData Point: %3"
-                              "\nMessage: %4").arg(QString::fromStdString(check.host).replace("\n", " "),
-                                                         (check.host_groups.empty())? "-" : QString::fromStdString(check.host_groups),
+                              "\nMessage: %4").arg(QString::fromStdString(check->host).replace("\n", " "),
+                                                         (check->host_groups.empty())? "-" : QString::fromStdString(check->host_groups),
                                                          child_nodes.isEmpty()? "-" : child_nodes,
-                                                         QString::fromStdString(check.alarm_msg)));
+                                                         QString::fromStdString(check->alarm_msg)));
   } else {
     result.append(QObject::tr("\nAlarm Message: %1").arg(actual_msg));
   }
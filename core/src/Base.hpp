@@ -66,6 +66,34 @@ struct CheckT {
 };
 typedef QMap<std::string, CheckT> ChecksT;
 
+/**
+ * @brief Copy-on-write reference to a check.
+ * Nodes bound to the same data point share the instance published in the CheckRegistry,
+ * edit() makes a private copy before any change so that shared instances are never modified.
+ */
+class CheckRefT {
+public:
+  CheckRefT(void) : m_check(emptyCheck()) {}
+  CheckRefT(const CheckT& check) : m_check(std::make_shared<CheckT>(check)) {}
+  explicit CheckRefT(const std::shared_ptr<CheckT>& check) : m_check(check) {}
+  const CheckT& operator*(void) const {return *m_check;}
+  const CheckT* operator->(void) const {return m_check.get();}
+  CheckT& edit(void) {
+    if (m_check.use_count() > 1) {
+      m_check = std::make_shared<CheckT>(*m_check);
+    }
+    return *m_check;
+  }
+
+private:
+  std::shared_ptr<CheckT> m_check;
+
+  static const std::shared_ptr<CheckT>& emptyCheck(void) {
+    static const std::shared_ptr<CheckT> check = std::make_shared<CheckT>(CheckT{"", "", "", "", "", "", -1});
+    return check;
+  }
+};
+
 class MonitorT {
 public:
   enum {
@@ -318,7 +346,7 @@ struct NodeT {
   QString actual_msg;
   double weight;
   QString child_nodes;
-  CheckT check;
+  CheckRefT check;
   QVector<ThresholdT> thresholdLimits;
   bool monitored;
   qint8 visibility;
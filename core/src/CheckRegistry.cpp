@@ -0,0 +1,87 @@
+/*
+ * CheckRegistry.cpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#include "CheckRegistry.hpp"
+#include "utilsCore.hpp"
+#include <QMutexLocker>
+
+
+namespace {
+  bool sameCheck(const CheckT& check1, const CheckT& check2)
+  {
+    return check1.status == check2.status
+        && check1.last_state_change == check2.last_state_change
+        && check1.alarm_msg == check2.alarm_msg
+        && check1.id == check2.id
+        && check1.host == check2.host
+        && check1.check_command == check2.check_command
+        && check1.host_groups == check2.host_groups;
+  }
+} // namespace
+
+
+CheckRegistry& CheckRegistry::instance(void)
+{
+  static CheckRegistry registry;
+  return registry;
+}
+
+
+QString CheckRegistry::dataPointKey(const QString& sid, const QString& checkId)
+{
+  return ngrt4n::realCheckId(sid, checkId).toLower();
+}
+
+
+CheckRefT CheckRegistry::publish(const QString& dataPointKey, const CheckT& check)
+{
+  QMutexLocker locker(&m_mutex);
+  auto& entry = m_checks[dataPointKey];
+  if (! entry || ! sameCheck(*entry, check)) {
+    // nodes still holding the former instance keep it until they get the new one
+    entry = std::make_shared<CheckT>(check);
+  }
+
+  CheckRefT checkRef(entry);
+  if (m_checks.size() >= m_pruneThreshold) {
+    pruneUnreferencedChecks();
+  }
+  return checkRef;
+}
+
+
+int CheckRegistry::size(void)
+{
+  QMutexLocker locker(&m_mutex);
+  return m_checks.size();
+}
+
+
+void CheckRegistry::pruneUnreferencedChecks(void)
+{
+  for (auto check = m_checks.begin(); check != m_checks.end(); ) {
+    check = (check.value().use_count() == 1) ? m_checks.erase(check) : std::next(check);
+  }
+  m_pruneThreshold = qMax(MIN_PRUNE_THRESHOLD, 2 * m_checks.size());
+}
@@ -0,0 +1,61 @@
+/*
+ * CheckRegistry.hpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#ifndef CHECKREGISTRY_HPP
+#define CHECKREGISTRY_HPP
+
+#include "Base.hpp"
+#include <QMutex>
+#include <QHash>
+
+
+/**
+ * @brief Process-wide registry of the checks fetched from the monitoring sources.
+ * Checks are keyed by normalized data point id (see dataPointKey) and published once per fetch,
+ * nodes of every view then hold a reference on the same instance. An unchanged check keeps its
+ * instance, and entries no longer referenced by any node are dropped as the registry grows.
+ */
+class CheckRegistry
+{
+public:
+  static CheckRegistry& instance(void);
+  static QString dataPointKey(const QString& sid, const QString& checkId);
+
+  CheckRefT publish(const QString& dataPointKey, const CheckT& check);
+  int size(void);
+
+private:
+  static constexpr int MIN_PRUNE_THRESHOLD = 1024;
+
+  QMutex m_mutex;
+  QHash<QString, std::shared_ptr<CheckT>> m_checks;
+  int m_pruneThreshold = MIN_PRUNE_THRESHOLD;
+
+  CheckRegistry(void) = default;
+  CheckRegistry(const CheckRegistry&) = delete;
+  CheckRegistry& operator=(const CheckRegistry&) = delete;
+  void pruneUnreferencedChecks(void);
+};
+
+#endif // CHECKREGISTRY_HPP
@@ -0,0 +1,237 @@
+/*
+ * CompiledView.cpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#include "CompiledView.hpp"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QDebug>
+
+
+CompiledView::CompiledView(const QString& cacheDir, const QString& viewFile, int parsingMode)
+  : m_cacheDir(cacheDir),
+    m_viewFile(viewFile),
+    m_parsingMode(parsingMode)
+{
+  QFileInfo viewFileInfo(viewFile);
+  m_viewFileSize = viewFileInfo.size();
+  m_viewFileMTime = viewFileInfo.lastModified().toMSecsSinceEpoch();
+}
+
+
+bool CompiledView::load(CoreDataT& cdata)
+{
+  QFile compiledFile(compiledFilePath());
+  if (! compiledFile.open(QIODevice::ReadOnly) || compiledFile.size() == 0) {
+    return false;
+  }
+
+  uchar* mappedData = compiledFile.map(0, compiledFile.size());
+  if (! mappedData) {
+    return false;
+  }
+
+  // the stream reads straight from the mapped pages, the file content is never copied
+  QByteArray rawData = QByteArray::fromRawData(reinterpret_cast<const char*>(mappedData), static_cast<int>(compiledFile.size()));
+  QDataStream in(rawData);
+
+  quint32 magic;
+  qint32 formatVersion;
+  qint32 parsingMode;
+  qint64 sourceSize;
+  qint64 sourceMTime;
+  QByteArray sourceHash;
+  in >> magic >> formatVersion;
+  if (in.status() == QDataStream::Ok && magic == MAGIC && formatVersion == FORMAT_VERSION) {
+    in >> parsingMode >> sourceSize >> sourceMTime >> sourceHash;
+  }
+  if (in.status() != QDataStream::Ok
+      || magic != MAGIC
+      || formatVersion != FORMAT_VERSION
+      || parsingMode != m_parsingMode
+      || ! isBuiltFromCurrentContent(sourceSize, sourceMTime, sourceHash)) {
+    compiledFile.unmap(mappedData);
+    return false;
+  }
+
+  qint8 monitor;
+  double formatVersionOfView;
+  NodeListT bpnodes;
+  NodeListT cnodes;
+  HostListT hosts;
+  QSet<QString> sources;
+  qint32 nodeCount;
+
+  in >> monitor >> formatVersionOfView;
+  for (auto nodes: {&bpnodes, &cnodes}) {
+    in >> nodeCount;
+    nodes->reserve(nodeCount);
+    for (qint32 index = 0; index < nodeCount && in.status() == QDataStream::Ok; ++index) {
+      NodeT node;
+      readNode(in, node);
+      nodes->insert(node.id, node);
+    }
+  }
+  in >> hosts >> sources;
+
+  const bool loaded = (in.status() == QDataStream::Ok);
+  compiledFile.unmap(mappedData);
+  if (! loaded) {
+    return false;
+  }
+
+  cdata.monitor = monitor;
+  cdata.format_version = formatVersionOfView;
+  cdata.bpnodes = bpnodes;
+  cdata.cnodes = cnodes;
+  cdata.hosts = hosts;
+  cdata.sources = sources;
+
+  return true;
+}
+
+
+void CompiledView::save(const CoreDataT& cdata)
+{
+  auto sourceHash = contentHash();
+  if (sourceHash.isEmpty()) {
+    return;
+  }
+
+  if (! QDir().mkpath(m_cacheDir)) {
+    qDebug() << QObject::tr("Cannot create compiled view directory: %1").arg(m_cacheDir);
+    return;
+  }
+
+  QSaveFile file(compiledFilePath());
+  if (! file.open(QIODevice::WriteOnly)) {
+    qDebug() << QObject::tr("Cannot write compiled view: %1").arg(file.fileName());
+    return;
+  }
+
+  QDataStream out(&file);
+  out << MAGIC << FORMAT_VERSION << static_cast<qint32>(m_parsingMode) << m_viewFileSize << m_viewFileMTime << sourceHash;
+  out << cdata.monitor << cdata.format_version;
+  for (auto nodes: {&cdata.bpnodes, &cdata.cnodes}) {
+    out << static_cast<qint32>(nodes->size());
+    for (const auto& node: *nodes) {
+      writeNode(out, node);
+    }
+  }
+  out << cdata.hosts << cdata.sources;
+
+  if (! file.commit()) {
+    qDebug() << QObject::tr("Cannot write compiled view: %1").arg(file.fileName());
+  }
+}
+
+
+QString CompiledView::compiledFilePath(void) const
+{
+  auto pathHash = QCryptographicHash::hash(m_viewFile.toUtf8(), QCryptographicHash::Sha1).toHex();
+  return QString("%1/%2-%3.view").arg(m_cacheDir, QString::fromLatin1(pathHash), QString::number(m_parsingMode));
+}
+
+
+bool CompiledView::isBuiltFromCurrentContent(qint64 sourceSize, qint64 sourceMTime, const QByteArray& sourceHash)
+{
+  // same size and modification time: the XML is not read at all
+  if (sourceSize == m_viewFileSize && sourceMTime == m_viewFileMTime) {
+    return true;
+  }
+  // the file was touched or rewritten, it may still hold the same content
+  return sourceSize == m_viewFileSize && sourceHash == contentHash();
+}
+
+
+QByteArray CompiledView::contentHash(void)
+{
+  if (m_contentHash.isEmpty()) {
+    QFile viewFile(m_viewFile);
+    if (viewFile.open(QIODevice::ReadOnly)) {
+      QCryptographicHash hash(QCryptographicHash::Sha1);
+      hash.addData(&viewFile);
+      m_contentHash = hash.result();
+    }
+  }
+  return m_contentHash;
+}
+
+
+void CompiledView::writeNode(QDataStream& out, const NodeT& node)
+{
+  out << node.id
+      << node.name
+      << node.type
+      << node.sev_crule
+      << node.sev_prule
+      << node.icon
+      << node.description
+      << node.parents
+      << node.alarm_msg
+      << node.notification_msg
+      << node.weight
+      << node.child_nodes
+      << static_cast<qint32>(node.thresholdLimits.size());
+  for (const auto& threshold: node.thresholdLimits) {
+    out << threshold.weight << static_cast<qint32>(threshold.sev_in) << static_cast<qint32>(threshold.sev_out);
+  }
+}
+
+
+void CompiledView::readNode(QDataStream& in, NodeT& node)
+{
+  qint32 thresholdCount;
+  in >> node.id
+     >> node.name
+     >> node.type
+     >> node.sev_crule
+     >> node.sev_prule
+     >> node.icon
+     >> node.description
+     >> node.parents
+     >> node.alarm_msg
+     >> node.notification_msg
+     >> node.weight
+     >> node.child_nodes
+     >> thresholdCount;
+  for (qint32 index = 0; index < thresholdCount && in.status() == QDataStream::Ok; ++index) {
+    ThresholdT threshold;
+    qint32 sevIn;
+    qint32 sevOut;
+    in >> threshold.weight >> sevIn >> sevOut;
+    threshold.sev_in = sevIn;
+    threshold.sev_out = sevOut;
+    node.thresholdLimits.push_back(threshold);
+  }
+
+  // same runtime state as a node freshly read from XML
+  node.monitored = false;
+  node.sev = ngrt4n::Unknown;
+  node.sev_prop = ngrt4n::Unknown;
+  node.check = CheckRefT();
+}
@@ -0,0 +1,64 @@
+/*
+ * CompiledView.hpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#ifndef COMPILEDVIEW_HPP
+#define COMPILEDVIEW_HPP
+
+#include "Base.hpp"
+#include <QDataStream>
+
+
+/**
+ * @brief Compiled form of a parsed view file.
+ * Holds the parsed nodes, rules, thresholds and data point indexes of a view in a compact binary file,
+ * so that later loads skip XML tokenizing and entity decoding. The compiled file is memory-mapped when read,
+ * and is only trusted when it was built from the same XML content (SHA-1) and with the same parsing mode.
+ * The XML file is only read and hashed when its size or modification time differ from the ones recorded at build time.
+ */
+class CompiledView
+{
+public:
+  static const quint32 MAGIC = 0x524f4956; // "ROIV"
+  static const qint32 FORMAT_VERSION = 2;
+
+  CompiledView(const QString& cacheDir, const QString& viewFile, int parsingMode);
+  bool load(CoreDataT& cdata);
+  void save(const CoreDataT& cdata);
+
+private:
+  QString m_cacheDir;
+  QString m_viewFile;
+  int m_parsingMode;
+  QByteArray m_contentHash;
+  qint64 m_viewFileSize;
+  qint64 m_viewFileMTime;
+
+  QString compiledFilePath(void) const;
+  bool isBuiltFromCurrentContent(qint64 sourceSize, qint64 sourceMTime, const QByteArray& sourceHash);
+  QByteArray contentHash(void);
+  static void writeNode(QDataStream& out, const NodeT& node);
+  static void readNode(QDataStream& in, NodeT& node);
+};
+
+#endif // COMPILEDVIEW_HPP
@@ -28,6 +28,8 @@
 #include "LsHelper.hpp"
 #include "StatusAggregator.hpp"
 #include "K8sHelper.hpp"
+#include "SourceCircuitBreaker.hpp"
+#include "CheckRegistry.hpp"
 #include <QNetworkCookieJar>
 #include <sstream>
 #include <QObject>
@@ -73,7 +75,9 @@ StringMapT DashboardBase::calcRules() {
 
 DashboardBase::DashboardBase(DbSession* dbSession)
   : m_dbSession(dbSession),
-    m_timerId(-1)
+    m_timerId(-1),
+    m_viewStatuses(nullptr),
+    m_updateCycle(0)
 {
   resetStatData();
 }
@@ -92,7 +96,8 @@ std::pair<int, QString> DashboardBase::initialize(const QString& vfile)
     return std::make_pair(ngrt4n::RcGenericFailure, QObject::tr("initialize: db session not initialized"));
   }
 
-  Parser parser{&m_cdata, Parser::ParsingModeDashboard, m_dbSession};
+  m_viewFile = vfile;
+  Parser parser{&m_cdata, parsingMode(), m_dbSession};
   auto parseOut = parser.parse(vfile);
   if (parseOut.first != ngrt4n::RcSuccess) {
     return std::make_pair(parseOut.first, parseOut.second);
@@ -108,6 +113,8 @@ std::pair<int, QString> DashboardBase::initialize(const QString& vfile)
     return std::make_pair(rc, parser.lastErrorMsg());
   }
 
+  indexDataPoints();
+
   return std::make_pair(ngrt4n::RcSuccess, "");
 }
 
@@ -118,15 +125,30 @@ std::pair<int, QString> DashboardBase::updateAllNodesStatus(void)
   }
 
   resetStatData();
+  m_failedSources.clear();
   for (const auto& sid: m_cdata.sources) {
     auto src = m_sources.constFind(sid);
     if (src != std::cend(m_sources)) {
+      auto& sourceBreaker = SourceCircuitBreaker::instance();
+      if (sourceBreaker.isOpen(sid)) {
+        updateDashboardOnError(*src, QObject::tr("%1 is unreachable, retrying in background").arg(sid));
+        sourceBreaker.probeInBackground(*src, probeFilter(*src));
+        finalizeUpdate(*src);
+        continue;
+      }
       signalUpdateProcessing(*src);
+      beginSourceUpdate(*src);
       if (m_cdata.monitor != MonitorT::Any) {
         runDynamicViewByGroupUpdate(*src);
       } else {
         runGenericViewUpdate(*src);
       }
+      endSourceUpdate(*src);
+      if (m_failedSources.contains(sid)) {
+        sourceBreaker.recordFailure(sid, m_updateCycle);
+      } else {
+        sourceBreaker.recordSuccess(sid, monitoredChecks(sid));
+      }
       finalizeUpdate(*src);
     } else {
        SourceT unknownSrc;
@@ -155,37 +177,126 @@ void DashboardBase::signalUpdateProcessing(const SourceT& src)
 
 void DashboardBase::runDynamicViewByGroupUpdate(const SourceT& sinfo)
 {
+  CoreDataT newCData;
   if (sinfo.mon_type == MonitorT::Kubernetes) {
-    CoreDataT newCData;
     auto viewLoaded = K8sHelper(sinfo.mon_url, sinfo.verify_ssl_peer, sinfo.auth).loadNamespaceView(rootNode().name, newCData);
     if (viewLoaded.second != ngrt4n::RcSuccess) {
       updateDashboardOnError(sinfo, viewLoaded.first);
       return ;
     }
-
-    for (const auto& newCNode: newCData.cnodes) {
-      auto cnode = m_cdata.cnodes.find(newCNode.id);
-      if (cnode != m_cdata.cnodes.end()) { // pod may disappear due to restart, but a notification should be displayed in event feed.
-        cnode->check = newCNode.check;
-        updateNodeStatusInfo(*cnode, sinfo);
-        updateDashboard(*cnode);
-        cnode->monitored = true;
-      }
-    }
   } else {
     ChecksT checks;
     auto importResult = ngrt4n::loadDataItems(sinfo, rootNode().name, checks);
     if (importResult.first != ngrt4n::RcSuccess) {
       updateDashboardOnError(sinfo, importResult.second);
-    } else {
-      updateCNodesWithChecks(checks, sinfo);
+      return ;
+    }
+    ngrt4n::buildDynamicViewByGroup(sinfo, rootNode().name, checks, newCData);
+    ngrt4n::fixupDependencies(newCData);
+  }
+
+  // an empty fetch is more likely a glitch of the source than an emptied group, and vanished pods are
+  // kept so that finalizeUpdate() flags them as no longer existing
+  syncDynamicViewTopology(newCData, sinfo.mon_type != MonitorT::Kubernetes && ! newCData.cnodes.isEmpty());
+
+  auto& checkRegistry = CheckRegistry::instance();
+  for (const auto& newCNode: newCData.cnodes) {
+    auto cnode = m_cdata.cnodes.find(newCNode.id);
+    if (cnode != m_cdata.cnodes.end()) {
+      auto dataPointKey = CheckRegistry::dataPointKey(sinfo.id, QString::fromStdString(newCNode.check->id));
+      cnode->check = checkRegistry.publish(dataPointKey, *newCNode.check);
+      updateNodeStatusInfo(*cnode, sinfo);
+      updateDashboard(*cnode);
+      cnode->monitored = true;
     }
   }
 }
 
 
+void DashboardBase::syncDynamicViewTopology(const CoreDataT& newCData, bool removeVanishedNodes)
+{
+  // node ids are stable across loads (see ngrt4n::buildDynamicViewByGroup and K8sHelper),
+  // so the view is patched in place instead of being parsed and laid out again
+  bool topologyChanged = false;
+  auto removeVanished = [this, &topologyChanged](NodeListT& nodes, const NodeListT& newNodes) {
+    for (auto node = nodes.begin(); node != nodes.end(); ) {
+      if (node->id == ngrt4n::ROOT_ID || newNodes.contains(node->id)) {
+        ++node;
+        continue;
+      }
+      removeDynamicNode(*node);
+      node = nodes.erase(node);
+      topologyChanged = true;
+    }
+  };
+  QStringList addedNodeIds;
+  auto insertNewNodes = [&addedNodeIds](NodeListT& nodes, const NodeListT& newNodes, qint8 visibility) {
+    for (const auto& newNode: newNodes) {
+      if (nodes.contains(newNode.id)) {
+        continue;
+      }
+      auto node = nodes.insert(newNode.id, newNode);
+      node->visibility = visibility;
+      addedNodeIds.push_back(newNode.id);
+    }
+  };
+
+  // children go before their parents, and the other way round for insertions
+  if (removeVanishedNodes) {
+    removeVanished(m_cdata.cnodes, newCData.cnodes);
+    removeVanished(m_cdata.bpnodes, newCData.bpnodes);
+  }
+  insertNewNodes(m_cdata.bpnodes, newCData.bpnodes, ngrt4n::Visible|ngrt4n::Expanded);
+  insertNewNodes(m_cdata.cnodes, newCData.cnodes, ngrt4n::Visible);
+
+  if (! topologyChanged && addedNodeIds.isEmpty()) {
+    return;
+  }
+
+  // kept vanished nodes keep their links, and stay listed among the children of their parents
+  for (auto& bpnode: m_cdata.bpnodes) {
+    auto newBpnode = newCData.bpnodes.constFind(bpnode.id);
+    if (newBpnode == newCData.bpnodes.cend()) {
+      continue;
+    }
+    auto childIds = newBpnode->child_nodes.split(ngrt4n::CHILD_Q_SEP, QString::SkipEmptyParts);
+    for (const auto& childId: bpnode.child_nodes.split(ngrt4n::CHILD_Q_SEP, QString::SkipEmptyParts)) {
+      if (! childIds.contains(childId) && (m_cdata.cnodes.contains(childId) || m_cdata.bpnodes.contains(childId))) {
+        childIds.push_back(childId);
+      }
+    }
+    bpnode.child_nodes = childIds.join(ngrt4n::CHILD_Q_SEP);
+  }
+  for (auto& cnode: m_cdata.cnodes) {
+    auto newCnode = newCData.cnodes.constFind(cnode.id);
+    if (newCnode != newCData.cnodes.cend()) {
+      cnode.parents = newCnode->parents;
+    }
+  }
+
+  // surviving nodes are pinned to their latest positions, only the new ones get placed
+  if (parsingMode() != Parser::ParsingModeCollector) {
+    Parser parser{&m_cdata, parsingMode(), m_dbSession};
+    parser.setViewFile(m_viewFile);
+    parser.computeCoordinates();
+  }
+
+  for (const auto& nodeId: addedNodeIds) {
+    NodeListT::Iterator node;
+    if (ngrt4n::findNode(&m_cdata, nodeId, node)) {
+      addDynamicNode(*node);
+    }
+  }
+  updateDynamicLayout();
+  indexDataPoints();
+}
+
+
 void DashboardBase::runGenericViewUpdate(const SourceT& srcInfo)
 {
+  // the source is only failed when none of its hosts could be fetched
+  bool failed = false;
+  QString lastError;
   for (const auto& hitem: m_cdata.hosts.keys()) { //FIXME: avoid iteration for Pandora FMS => all modules are fetched once
     StringPairT info = ngrt4n::splitSourceDataPointInfo(hitem);
     if (info.first != srcInfo.id) {
@@ -194,12 +305,16 @@ void DashboardBase::runGenericViewUpdate(const SourceT& srcInfo)
     ChecksT checks;
     auto importResult = ngrt4n::loadDataItems(srcInfo, info.second, checks);
     if (importResult.first != ngrt4n::RcSuccess) {
-      updateDashboardOnError(srcInfo, importResult.second);
+      failed = true;
+      lastError = importResult.second;
     } else {
       updateCNodesWithChecks(checks, srcInfo);
-      break;
+      return;
     }
   }
+  if (failed) {
+    updateDashboardOnError(srcInfo, lastError);
+  }
 }
 
 
@@ -224,14 +339,32 @@ void DashboardBase::updateDashboard(const NodeT& _node)
 
 void DashboardBase::updateCNodesWithCheck(const CheckT& check, const SourceT& src)
 {
-  for (auto& cnode: m_cdata.cnodes) {
-    if (cnode.child_nodes.toLower() != ngrt4n::realCheckId(src.id, QString::fromStdString(check.id)).toLower()) {
+  auto dataPointKey = CheckRegistry::dataPointKey(src.id, QString::fromStdString(check.id));
+  auto subscribedNodes = m_cnodesByDataPoint.values(dataPointKey);
+  if (subscribedNodes.isEmpty()) {
+    return;
+  }
+
+  // published once, then shared by all the nodes bound to the data point, in this view and others
+  auto checkRef = CheckRegistry::instance().publish(dataPointKey, check);
+  for (const auto& nodeId: subscribedNodes) {
+    auto cnode = m_cdata.cnodes.find(nodeId);
+    if (cnode == m_cdata.cnodes.end()) {
       continue;
     }
-    cnode.check = check;
-    updateNodeStatusInfo(cnode, src);
-    updateDashboard(cnode);
-    cnode.monitored = true;
+    cnode->check = checkRef;
+    updateNodeStatusInfo(*cnode, src);
+    updateDashboard(*cnode);
+    cnode->monitored = true;
+  }
+}
+
+
+void DashboardBase::indexDataPoints(void)
+{
+  m_cnodesByDataPoint.clear();
+  for (const auto& cnode: m_cdata.cnodes) {
+    m_cnodesByDataPoint.insert(cnode.child_nodes.toLower(), cnode.id);
   }
 }
 
@@ -245,19 +378,19 @@ void DashboardBase::updateCNodesWithChecks(const ChecksT& checks, const SourceT&
 void DashboardBase::updateNodeStatusInfo(NodeT& _node, const SourceT& src)
 {
   QRegExp regexp;
-  _node.sev = ngrt4n::severityFromProbeStatus(src.mon_type, _node.check.status);
+  _node.sev = ngrt4n::severityFromProbeStatus(src.mon_type, _node.check->status);
   _node.sev_prop = StatusAggregator::propagate(_node.sev, _node.sev_prule);
-  _node.actual_msg = QString::fromStdString(_node.check.alarm_msg);
+  _node.actual_msg = QString::fromStdString(_node.check->alarm_msg);
   
-  if (_node.check.host == "-") {
+  if (_node.check->host == "-") {
     return;
   }
   
   if (m_cdata.monitor == MonitorT::Zabbix) {
     regexp.setPattern(ngrt4n::TAG_ZABBIX_HOSTNAME.c_str());
-    _node.actual_msg.replace(regexp, _node.check.host.c_str());
+    _node.actual_msg.replace(regexp, _node.check->host.c_str());
     regexp.setPattern(ngrt4n::TAG_ZABBIX_HOSTNAME2.c_str());
-    _node.actual_msg.replace(regexp, _node.check.host.c_str());
+    _node.actual_msg.replace(regexp, _node.check->host.c_str());
   }
   
   if (_node.sev == ngrt4n::Normal) {
@@ -273,8 +406,8 @@ void DashboardBase::updateNodeStatusInfo(NodeT& _node, const SourceT& src)
   }
   
   regexp.setPattern(ngrt4n::TAG_HOSTNAME.c_str());
-  _node.actual_msg.replace(regexp, _node.check.host.c_str());
-  auto info = QString(_node.check.id.c_str()).split("/");
+  _node.actual_msg.replace(regexp, _node.check->host.c_str());
+  auto info = QString(_node.check->id.c_str()).split("/");
   
   if (info.length() > 1) {
     regexp.setPattern(ngrt4n::TAG_CHECK.c_str());
@@ -282,7 +415,7 @@ void DashboardBase::updateNodeStatusInfo(NodeT& _node, const SourceT& src)
   }
   
   if (m_cdata.monitor == MonitorT::Nagios) {
-    info = QString(_node.check.check_command.c_str()).split("!");
+    info = QString(_node.check->check_command.c_str()).split("!");
     if (info.length() >= 3) {
       regexp.setPattern(ngrt4n::TAG_THERESHOLD.c_str());
       _node.actual_msg.replace(regexp, info[1]);
@@ -318,29 +451,35 @@ ngrt4n::AggregatedSeverityT DashboardBase::computeBpNodeStatus(const QString& _n
     return status2Propagate;
   }
 
-  // if external service handle it through last status fetched from database
+  // if external service, take the status of the referenced view when it has been evaluated
+  // in this process, otherwise the last status fetched from database
   if (node->type == NodeType::ExternalService) {
     constexpr long intervalDurationSec = 10 * 60;
     long toDate = std::time(nullptr);
     long fromDate = toDate - intervalDurationSec;
-    PlatformMappedStatusHistoryT pfStatusMap;
 
-    node->check.host = "-";
-    node->check.host_groups = "-";
-    node->check.check_command = "-";
-    node->check.last_state_change = std::to_string(toDate);
+    auto& externalCheck = node->check.edit();
+    externalCheck.host = "-";
+    externalCheck.host_groups = "-";
+    externalCheck.check_command = "-";
+    externalCheck.last_state_change = std::to_string(toDate);
 
-    auto listOfExternalViews = node->child_nodes.toStdString();
-    int rc = p_dbSession->listStatusHistory(pfStatusMap, listOfExternalViews, fromDate, toDate);
-    if (rc > 0) {
-      node->sev = pfStatusMap[listOfExternalViews].back().status;
+    // like the database fallback, statuses kept in memory are only used within the last interval
+    auto viewStatus = m_viewStatuses ? m_viewStatuses->constFind(node->child_nodes) : ViewStatusMapT::const_iterator();
+    if (m_viewStatuses && viewStatus != m_viewStatuses->cend() && viewStatus->timestamp >= fromDate) {
+      node->sev = viewStatus->sev;
       node->actual_msg = QObject::tr("external service - %1").arg(node->child_nodes);
     } else {
-      node->sev = ngrt4n::Unknown;
-      status2Propagate.sev = ngrt4n::Unknown;
-      node->actual_msg = QObject::tr("external service - %1 - no status found in last %2 minute(s)")
-                         .arg(node->child_nodes
-                              .arg(intervalDurationSec / 60));
+      PlatformStatusT lastStatus;
+      int rc = p_dbSession->getLastPlatformStatus(lastStatus, node->child_nodes.toStdString());
+      if (rc == 0 && lastStatus.timestamp >= fromDate) {
+        node->sev = lastStatus.status;
+        node->actual_msg = QObject::tr("external service - %1").arg(node->child_nodes);
+      } else {
+        node->sev = ngrt4n::Unknown;
+        node->actual_msg = QObject::tr("external service - %1 - no status found in last %2 minute(s)")
+                           .arg(node->child_nodes, QString::number(intervalDurationSec / 60));
+      }
     }
 
     status2Propagate.sev = StatusAggregator::propagate(node->sev, node->sev_prule);
@@ -373,20 +512,68 @@ ngrt4n::AggregatedSeverityT DashboardBase::computeBpNodeStatus(const QString& _n
 
 void DashboardBase::updateDashboardOnError(const SourceT& src, const QString& msg)
 {
+  m_failedSources.insert(src.id);
   if (! msg.isEmpty()) {
     Q_EMIT updateMessageChanged(msg.toStdString());
   }
 
+  auto& sourceBreaker = SourceCircuitBreaker::instance();
   for (auto& cnode: m_cdata.cnodes) {
     StringPairT info = ngrt4n::splitSourceDataPointInfo(cnode.child_nodes);
     if (info.first != src.id) continue;
-    ngrt4n::setCheckOnError(-1, msg, cnode.check);
-    updateNodeStatusInfo(cnode, src);
+    qint64 staleSince = 0;
+    // a source failing below the threshold shows the error, its last good checks are only served once short-circuited
+    if (sourceBreaker.isOpen(src.id) && sourceBreaker.lastGoodCheck(src.id, cnode.child_nodes, cnode.check, staleSince)) {
+      updateNodeStatusInfo(cnode, src);
+      cnode.actual_msg.append(QObject::tr(" (stale since %1)").arg(QDateTime::fromTime_t(static_cast<uint>(staleSince)).toString()));
+    } else {
+      ngrt4n::setCheckOnError(-1, msg, cnode.check.edit());
+      updateNodeStatusInfo(cnode, src);
+    }
     cnode.monitored = true;
     updateDashboard(cnode);
   }
 }
 
+
+QSet<QString> DashboardBase::externalViews(void) const
+{
+  QSet<QString> views;
+  for (const auto& bpnode: m_cdata.bpnodes) {
+    if (bpnode.type == NodeType::ExternalService && ! bpnode.child_nodes.isEmpty()) {
+      views.insert(bpnode.child_nodes);
+    }
+  }
+  return views;
+}
+
+
+QHash<QString, CheckRefT> DashboardBase::monitoredChecks(const QString& sid) const
+{
+  QHash<QString, CheckRefT> checks;
+  for (const auto& cnode: m_cdata.cnodes) {
+    if (cnode.monitored && ngrt4n::splitSourceDataPointInfo(cnode.child_nodes).first == sid) {
+      checks.insert(cnode.child_nodes, cnode.check);
+    }
+  }
+  return checks;
+}
+
+
+QString DashboardBase::probeFilter(const SourceT& src)
+{
+  if (m_cdata.monitor != MonitorT::Any) {
+    return rootNode().name;
+  }
+  for (const auto& hitem: m_cdata.hosts.keys()) {
+    StringPairT info = ngrt4n::splitSourceDataPointInfo(hitem);
+    if (info.first == src.id) {
+      return info.second;
+    }
+  }
+  return QString();
+}
+
 std::pair<int, QString> DashboardBase::loadDataSources(void)
 {
   if (! m_dbSession) {
@@ -408,22 +595,22 @@ void DashboardBase::finalizeUpdate(const SourceT& src)
     switch (src.mon_type) {
       case MonitorT::Any:
         if (std::regex_match(cnode.child_nodes.toStdString(), std::regex(QString("%1:.+").arg(src.id).toStdString()))) {
-          ngrt4n::setCheckOnError(ngrt4n::Unset, tr("Undefined service (%1)").arg(cnode.child_nodes), cnode.check);
+          ngrt4n::setCheckOnError(ngrt4n::Unset, tr("Undefined service (%1)").arg(cnode.child_nodes), cnode.check.edit());
           updateNodeStatusInfo(cnode, src);
           updateDashboard(cnode);
         }
         break;
       case MonitorT::Kubernetes:
         cnode.sev = ngrt4n::Critical;
-        cnode.check.status = ngrt4n::K8sFailed;
-        cnode.check.alarm_msg = QObject::tr("Pod %1 seems to no longer exist").arg(cnode.child_nodes).toStdString();
+        cnode.check.edit().status = ngrt4n::K8sFailed;
+        cnode.check.edit().alarm_msg = QObject::tr("Pod %1 seems to no longer exist").arg(cnode.child_nodes).toStdString();
         updateNodeStatusInfo(cnode, src);
         updateDashboard(cnode);
         break;
       default:
         cnode.sev = ngrt4n::Critical;
-        cnode.check.status = ngrt4n::Unset;
-        cnode.check.alarm_msg = QObject::tr("Item %1 seems to no longer exist").arg(cnode.child_nodes).toStdString();
+        cnode.check.edit().status = ngrt4n::Unset;
+        cnode.check.edit().alarm_msg = QObject::tr("Item %1 seems to no longer exist").arg(cnode.child_nodes).toStdString();
         updateNodeStatusInfo(cnode, src);
         updateDashboard(cnode);
         break;
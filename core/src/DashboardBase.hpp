@@ -27,6 +27,7 @@
 
 #include "Base.hpp"
 #include "Parser.hpp"
+#include "ViewDependencyGraph.hpp"
 #include "ZbxHelper.hpp"
 #include "dbo/src/DbSession.hpp"
 #include <QString>
@@ -74,6 +75,12 @@ public Q_SLOTS:
   virtual std::pair<int, QString> initialize(const QString& vfile);
   qint32 userRole(void) const {return m_userRole;}
   SourceListT sources(void) {return m_sources;}
+  void setSources(const SourceListT& sources) {m_sources = sources;}
+  QSet<QString> sourceIds(void) const {return m_cdata.sources;}
+  QSet<QString> failedSources(void) const {return m_failedSources;}
+  QSet<QString> externalViews(void) const;
+  void setViewStatuses(const ViewStatusMapT* viewStatuses) {m_viewStatuses = viewStatuses;}
+  void setUpdateCycle(quint64 cycle) {m_updateCycle = cycle;} // source failures are counted once per cycle, 0 counts each update
   void setShowOnlyProblemMsgsState(bool state) {m_showOnlyProblemMsgsState = state;}
 
 Q_SIGNALS:
@@ -92,6 +99,12 @@ protected:
   virtual void updateTree(const NodeT& _node, const QString& _tip) = 0;
   virtual void updateMsgConsole(const NodeT& _node) = 0;
   virtual void finalizeUpdate(const SourceT& src);
+  virtual int parsingMode(void) const {return Parser::ParsingModeDashboard;}
+  virtual void beginSourceUpdate(const SourceT&) {}
+  virtual void endSourceUpdate(const SourceT&) {}
+  virtual void addDynamicNode(const NodeT&) {}
+  virtual void removeDynamicNode(const NodeT&) {}
+  virtual void updateDynamicLayout(void) {}
   virtual void updateChart(void) = 0;
   virtual void updateEventFeeds(const NodeT& node) = 0;
 
@@ -103,11 +116,20 @@ private:
   qint32 m_interval;
   QSize m_msgConsoleSize;
   SourceListT m_sources;
+  QSet<QString> m_failedSources;
+  QString m_viewFile;
+  const ViewStatusMapT* m_viewStatuses;
+  quint64 m_updateCycle;
+  QMultiHash<QString, QString> m_cnodesByDataPoint; // data points the view subscribes to => bound cnodes
   void signalUpdateProcessing(const SourceT& src);
   void updateCNodesWithCheck(const CheckT & check, const SourceT& src);
   void updateCNodesWithChecks(const ChecksT& checks, const SourceT& src);
   void computeFirstSrcIndex(void);
   void updateDashboardOnError(const SourceT& src, const QString& msg);
+  void syncDynamicViewTopology(const CoreDataT& newCData, bool removeVanishedNodes);
+  void indexDataPoints(void);
+  QHash<QString, CheckRefT> monitoredChecks(const QString& sid) const;
+  QString probeFilter(const SourceT& src);
 };
 
 #endif /* SVNAVIGATOR_HPP */
@@ -0,0 +1,544 @@
+/*
+ * GraphLayout.cpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#include "GraphLayout.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <functional>
+#include <queue>
+
+
+namespace {
+  const double POINTS_PER_INCH = 72;
+  const double LABEL_CHAR_WIDTH = 7.7; // points, average width of a 14pt character
+  const double LABEL_MARGIN = 16; // points
+  const double MIN_NODE_WIDTH = 0.75;
+  const double NODE_HEIGHT = 0.5;
+  const double NODE_SEPARATION = 0.25;
+  const double RANK_SEPARATION = 0.5;
+  const int ORDERING_SWEEPS = 4;
+  const int ALIGNMENT_SWEEPS = 3;
+} // namespace
+
+
+GraphLayout::GraphLayout(int layoutType)
+  : m_layoutType(layoutType),
+    m_pinnedCount(0),
+    m_width(0),
+    m_height(0)
+{
+}
+
+
+void GraphLayout::addNode(const QString& id, const QString& label)
+{
+  if (m_indexes.contains(id)) {
+    return;
+  }
+  NodeBoxT box;
+  box.width = qMax(MIN_NODE_WIDTH, (label.size() * LABEL_CHAR_WIDTH + LABEL_MARGIN) / POINTS_PER_INCH);
+  box.height = NODE_HEIGHT;
+  m_indexes.insert(id, m_boxes.size());
+  m_boxes.push_back(box);
+  m_children.push_back(QVector<int>());
+  m_parents.push_back(QVector<int>());
+  m_pinned.push_back(false);
+}
+
+
+void GraphLayout::addEdge(const QString& parentId, const QString& childId)
+{
+  auto parent = m_indexes.constFind(parentId);
+  auto child = m_indexes.constFind(childId);
+  if (parent == m_indexes.cend() || child == m_indexes.cend() || *parent == *child) {
+    return;
+  }
+  m_children[*parent].push_back(*child);
+  m_parents[*child].push_back(*parent);
+}
+
+
+void GraphLayout::pinNode(const QString& id, double x, double y)
+{
+  auto index = m_indexes.constFind(id);
+  if (index == m_indexes.cend()) {
+    return;
+  }
+  m_boxes[*index].x = x;
+  m_boxes[*index].y = y;
+  if (! m_pinned[*index]) {
+    m_pinned[*index] = true;
+    ++m_pinnedCount;
+  }
+}
+
+
+void GraphLayout::run(void)
+{
+  m_width = 0;
+  m_height = 0;
+  if (m_boxes.isEmpty()) {
+    return;
+  }
+
+  auto ranks = computeRanks();
+  if (m_pinnedCount > 0) {
+    runIncrementalLayout(ranks);
+  } else if (m_layoutType == ngrt4n::NeatoLayout) {
+    runRadialLayout(ranks);
+  } else {
+    runLayeredLayout(ranks);
+  }
+  normalize();
+}
+
+
+GraphLayout::NodeBoxT GraphLayout::box(const QString& id) const
+{
+  auto index = m_indexes.constFind(id);
+  return (index != m_indexes.cend()) ? m_boxes[*index] : NodeBoxT();
+}
+
+
+/**
+ * Longest-path ranking: each node lies one rank below its deepest parent.
+ * Cycles aren't rejected by the editor, they are broken by releasing
+ * the pending node that has the fewest unranked parents, taken from a heap
+ * that gets a new entry each time a count decreases (outdated entries are skipped).
+ */
+QVector<int> GraphLayout::computeRanks(void) const
+{
+  const int nodeCount = m_boxes.size();
+  QVector<int> ranks(nodeCount, 0);
+  QVector<int> pendingParents(nodeCount, 0);
+  QVector<bool> queued(nodeCount, false);
+  QVector<bool> processed(nodeCount, false);
+  QVector<int> queue;
+  queue.reserve(nodeCount);
+  typedef std::pair<int, int> PendingEntryT; // pending parent count, node
+  std::priority_queue<PendingEntryT, std::vector<PendingEntryT>, std::greater<PendingEntryT>> releaseCandidates;
+
+  for (int node = 0; node < nodeCount; ++node) {
+    pendingParents[node] = m_parents[node].size();
+    if (pendingParents[node] == 0) {
+      queued[node] = true;
+      queue.push_back(node);
+    } else {
+      releaseCandidates.push({pendingParents[node], node});
+    }
+  }
+
+  int head = 0;
+  while (head < nodeCount) {
+    if (head == queue.size()) {
+      while (queued[releaseCandidates.top().second]
+             || releaseCandidates.top().first != pendingParents[releaseCandidates.top().second]) {
+        releaseCandidates.pop();
+      }
+      int released = releaseCandidates.top().second;
+      releaseCandidates.pop();
+      queued[released] = true;
+      queue.push_back(released);
+    }
+
+    int node = queue[head++];
+    processed[node] = true;
+    for (int child: m_children[node]) {
+      if (processed[child]) {
+        continue;
+      }
+      ranks[child] = qMax(ranks[child], ranks[node] + 1);
+      if (queued[child]) {
+        --pendingParents[child];
+      } else if (--pendingParents[child] == 0) {
+        queued[child] = true;
+        queue.push_back(child);
+      } else {
+        releaseCandidates.push({pendingParents[child], child});
+      }
+    }
+  }
+
+  return ranks;
+}
+
+
+void GraphLayout::runLayeredLayout(const QVector<int>& ranks)
+{
+  const int nodeCount = m_boxes.size();
+  const int maxRank = *std::max_element(ranks.cbegin(), ranks.cend());
+  QVector<QVector<int>> layers(maxRank + 1);
+
+  // initial order: a depth-first walk from the roots keeps subtrees contiguous
+  QVector<bool> visited(nodeCount, false);
+  QVector<int> stack;
+  auto visitFrom = [&](int start) {
+    stack.push_back(start);
+    while (! stack.isEmpty()) {
+      int node = stack.takeLast();
+      if (visited[node]) {
+        continue;
+      }
+      visited[node] = true;
+      layers[ranks[node]].push_back(node);
+      for (auto child = m_children[node].crbegin(); child != m_children[node].crend(); ++child) {
+        if (! visited[*child]) {
+          stack.push_back(*child);
+        }
+      }
+    }
+  };
+  for (int node = 0; node < nodeCount; ++node) {
+    if (m_parents[node].isEmpty()) {
+      visitFrom(node);
+    }
+  }
+  for (int node = 0; node < nodeCount; ++node) {
+    if (! visited[node]) {
+      visitFrom(node);
+    }
+  }
+
+  // reduce crossings with barycenter sweeps
+  QVector<int> order(nodeCount, 0);
+  QVector<double> keys(nodeCount, 0);
+  auto updateOrder = [&order](const QVector<int>& layer) {
+    for (int index = 0; index < layer.size(); ++index) {
+      order[layer[index]] = index;
+    }
+  };
+  auto sortByBarycenter = [&](QVector<int>& layer, const QVector<QVector<int>>& neighbours) {
+    for (int node: layer) {
+      double sum = 0;
+      for (int neighbour: neighbours[node]) {
+        sum += order[neighbour];
+      }
+      keys[node] = neighbours[node].isEmpty() ? order[node] : sum / neighbours[node].size();
+    }
+    std::stable_sort(layer.begin(), layer.end(), [&keys](int lhs, int rhs) { return keys[lhs] < keys[rhs]; });
+    updateOrder(layer);
+  };
+
+  for (const auto& layer: layers) {
+    updateOrder(layer);
+  }
+  for (int sweep = 0; sweep < ORDERING_SWEEPS; ++sweep) {
+    for (int rank = 1; rank <= maxRank; ++rank) {
+      sortByBarycenter(layers[rank], m_parents);
+    }
+    for (int rank = maxRank - 1; rank >= 0; --rank) {
+      sortByBarycenter(layers[rank], m_children);
+    }
+  }
+
+  // pack each layer, then center children under their parents and parents over their children
+  for (const auto& layer: layers) {
+    double x = 0;
+    for (int node: layer) {
+      m_boxes[node].x = x + m_boxes[node].width / 2;
+      x += m_boxes[node].width + NODE_SEPARATION;
+    }
+  }
+  auto alignTo = [this](const QVector<int>& layer, const QVector<QVector<int>>& neighbours) {
+    QVector<double> desiredX;
+    desiredX.reserve(layer.size());
+    for (int node: layer) {
+      if (neighbours[node].isEmpty()) {
+        desiredX.push_back(m_boxes[node].x);
+      } else {
+        double sum = 0;
+        for (int neighbour: neighbours[node]) {
+          sum += m_boxes[neighbour].x;
+        }
+        desiredX.push_back(sum / neighbours[node].size());
+      }
+    }
+    placeLayer(layer, desiredX);
+  };
+  for (int sweep = 0; sweep < ALIGNMENT_SWEEPS; ++sweep) {
+    for (int rank = 1; rank <= maxRank; ++rank) {
+      alignTo(layers[rank], m_parents);
+    }
+    for (int rank = maxRank - 1; rank >= 0; --rank) {
+      alignTo(layers[rank], m_children);
+    }
+  }
+
+  for (int node = 0; node < nodeCount; ++node) {
+    m_boxes[node].y = ranks[node] * (NODE_HEIGHT + RANK_SEPARATION) + NODE_HEIGHT / 2;
+  }
+}
+
+
+/**
+ * Moves the nodes of a layer as close as possible to their desired position while keeping
+ * their order and the node separation: the mean of the leftmost and the rightmost
+ * feasible placements satisfies both constraints and stays centered on the desired positions.
+ */
+void GraphLayout::placeLayer(const QVector<int>& layer, const QVector<double>& desiredX)
+{
+  const int size = layer.size();
+  if (size == 0) {
+    return;
+  }
+
+  auto gap = [&](int index) {
+    return (m_boxes[layer[index - 1]].width + m_boxes[layer[index]].width) / 2 + NODE_SEPARATION;
+  };
+
+  QVector<double> fromLeft(size);
+  QVector<double> fromRight(size);
+  fromLeft[0] = desiredX[0];
+  for (int index = 1; index < size; ++index) {
+    fromLeft[index] = qMax(desiredX[index], fromLeft[index - 1] + gap(index));
+  }
+  fromRight[size - 1] = desiredX[size - 1];
+  for (int index = size - 2; index >= 0; --index) {
+    fromRight[index] = qMin(desiredX[index], fromRight[index + 1] - gap(index + 1));
+  }
+  for (int index = 0; index < size; ++index) {
+    m_boxes[layer[index]].x = (fromLeft[index] + fromRight[index]) / 2;
+  }
+}
+
+
+/**
+ * Radial layout: the root sits at the center and each rank lies on a ring, every subtree
+ * owning an angular wedge proportional to its number of leaves.
+ */
+void GraphLayout::runRadialLayout(const QVector<int>& ranks)
+{
+  const int nodeCount = m_boxes.size();
+
+  // spanning tree: each node hangs below one of its parents from the previous rank
+  QVector<QVector<int>> treeChildren(nodeCount);
+  QVector<int> treeRoots;
+  for (int node = 0; node < nodeCount; ++node) {
+    int treeParent = -1;
+    for (int parent: m_parents[node]) {
+      if (ranks[parent] == ranks[node] - 1) {
+        treeParent = parent;
+        break;
+      }
+    }
+    if (treeParent < 0) {
+      treeRoots.push_back(node);
+    } else {
+      treeChildren[treeParent].push_back(node);
+    }
+  }
+
+  QVector<int> byRank(nodeCount);
+  std::iota(byRank.begin(), byRank.end(), 0);
+  std::stable_sort(byRank.begin(), byRank.end(), [&ranks](int lhs, int rhs) { return ranks[lhs] < ranks[rhs]; });
+
+  QVector<double> leaves(nodeCount, 1);
+  for (auto node = byRank.crbegin(); node != byRank.crend(); ++node) {
+    if (! treeChildren[*node].isEmpty()) {
+      leaves[*node] = 0;
+      for (int child: treeChildren[*node]) {
+        leaves[*node] += leaves[child];
+      }
+    }
+  }
+
+  // several roots are laid out around an empty center
+  const int depthOffset = (treeRoots.size() > 1) ? 1 : 0;
+  const int maxDepth = *std::max_element(ranks.cbegin(), ranks.cend()) + depthOffset;
+  QVector<double> ringLengths(maxDepth + 1, 0);
+  for (int node = 0; node < nodeCount; ++node) {
+    ringLengths[ranks[node] + depthOffset] += m_boxes[node].width + NODE_SEPARATION;
+  }
+  QVector<double> radiuses(maxDepth + 1, 0);
+  for (int depth = 1; depth <= maxDepth; ++depth) {
+    radiuses[depth] = qMax(radiuses[depth - 1] + NEATO_EDGE_LENGTH, ringLengths[depth] / (2 * M_PI));
+  }
+
+  QVector<double> wedgeStarts(nodeCount, 0);
+  QVector<double> wedgeSizes(nodeCount, 0);
+  double rootLeaves = 0;
+  for (int root: treeRoots) {
+    rootLeaves += leaves[root];
+  }
+  double angle = 0;
+  for (int root: treeRoots) {
+    wedgeStarts[root] = angle;
+    wedgeSizes[root] = 2 * M_PI * leaves[root] / rootLeaves;
+    angle += wedgeSizes[root];
+  }
+
+  for (int node: byRank) {
+    const double radius = radiuses[ranks[node] + depthOffset];
+    const double nodeAngle = wedgeStarts[node] + wedgeSizes[node] / 2;
+    m_boxes[node].x = radius * std::cos(nodeAngle);
+    m_boxes[node].y = radius * std::sin(nodeAngle);
+
+    double childStart = wedgeStarts[node];
+    for (int child: treeChildren[node]) {
+      wedgeStarts[child] = childStart;
+      wedgeSizes[child] = wedgeSizes[node] * leaves[child] / leaves[node];
+      childStart += wedgeSizes[child];
+    }
+  }
+}
+
+
+/**
+ * Places the nodes that aren't pinned, parents first: each one goes one rank below its placed
+ * parents (or away from the center in the radial layout), then is shifted sideways until it
+ * no longer overlaps a placed node. A grid index over the placed nodes keeps the overlap tests local.
+ */
+void GraphLayout::runIncrementalLayout(const QVector<int>& ranks)
+{
+  const int nodeCount = m_boxes.size();
+  const double rankStep = (m_layoutType == ngrt4n::NeatoLayout) ? NEATO_EDGE_LENGTH : NODE_HEIGHT + RANK_SEPARATION;
+  const double cellSize = 1.0;
+
+  QHash<qint64, QVector<int>> grid;
+  auto cellKey = [](qint64 column, qint64 row) { return (column << 32) ^ (row & 0xffffffff); };
+  auto forEachCell = [&](const NodeBoxT& box, const std::function<bool(qint64)>& handleCell) {
+    const qint64 firstColumn = static_cast<qint64>(std::floor((box.x - box.width / 2 - NODE_SEPARATION) / cellSize));
+    const qint64 lastColumn = static_cast<qint64>(std::floor((box.x + box.width / 2 + NODE_SEPARATION) / cellSize));
+    const qint64 firstRow = static_cast<qint64>(std::floor((box.y - box.height / 2 - NODE_SEPARATION) / cellSize));
+    const qint64 lastRow = static_cast<qint64>(std::floor((box.y + box.height / 2 + NODE_SEPARATION) / cellSize));
+    for (qint64 column = firstColumn; column <= lastColumn; ++column) {
+      for (qint64 row = firstRow; row <= lastRow; ++row) {
+        if (! handleCell(cellKey(column, row))) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+  auto insertInGrid = [&](int node) {
+    forEachCell(m_boxes[node], [&](qint64 cell) { grid[cell].push_back(node); return true; });
+  };
+  auto isFree = [&](const NodeBoxT& candidate) {
+    return forEachCell(candidate, [&](qint64 cell) {
+      for (int other: grid.value(cell)) {
+        if (std::abs(candidate.x - m_boxes[other].x) < (candidate.width + m_boxes[other].width) / 2 + NODE_SEPARATION
+            && std::abs(candidate.y - m_boxes[other].y) < (candidate.height + m_boxes[other].height) / 2 + NODE_SEPARATION) {
+          return false;
+        }
+      }
+      return true;
+    });
+  };
+
+  QVector<bool> placed(m_pinned);
+  double centerX = 0;
+  double centerY = 0;
+  double maxX = std::numeric_limits<double>::lowest();
+  for (int node = 0; node < nodeCount; ++node) {
+    if (placed[node]) {
+      insertInGrid(node);
+      centerX += m_boxes[node].x / m_pinnedCount;
+      centerY += m_boxes[node].y / m_pinnedCount;
+      maxX = qMax(maxX, m_boxes[node].x + m_boxes[node].width / 2);
+    }
+  }
+
+  QVector<int> byRank;
+  for (int node = 0; node < nodeCount; ++node) {
+    if (! placed[node]) {
+      byRank.push_back(node);
+    }
+  }
+  std::stable_sort(byRank.begin(), byRank.end(), [&ranks](int lhs, int rhs) { return ranks[lhs] < ranks[rhs]; });
+
+  for (int node: byRank) {
+    auto& box = m_boxes[node];
+    int anchorCount = 0;
+    double anchorX = 0;
+    double anchorY = 0;
+    for (int parent: m_parents[node]) {
+      if (placed[parent]) {
+        anchorX += m_boxes[parent].x;
+        anchorY += m_boxes[parent].y;
+        ++anchorCount;
+      }
+    }
+
+    if (anchorCount == 0) {
+      // orphan: start a new column right of the map
+      box.x = maxX + NODE_SEPARATION + box.width / 2;
+      box.y = ranks[node] * (NODE_HEIGHT + RANK_SEPARATION) + NODE_HEIGHT / 2;
+    } else {
+      anchorX /= anchorCount;
+      anchorY /= anchorCount;
+      if (m_layoutType == ngrt4n::NeatoLayout) {
+        double directionX = anchorX - centerX;
+        double directionY = anchorY - centerY;
+        const double norm = std::hypot(directionX, directionY);
+        if (norm > 0) {
+          directionX /= norm;
+          directionY /= norm;
+        } else {
+          directionX = 1;
+          directionY = 0;
+        }
+        box.x = anchorX + directionX * rankStep;
+        box.y = anchorY + directionY * rankStep;
+      } else {
+        box.x = anchorX;
+        box.y = anchorY + rankStep;
+      }
+    }
+
+    // shift sideways, alternately right and left, until a free slot is found
+    const double desiredX = box.x;
+    const double shiftStep = box.width + NODE_SEPARATION;
+    for (int attempt = 1; ! isFree(box); ++attempt) {
+      box.x = desiredX + ((attempt % 2 == 1) ? 1 : -1) * ((attempt + 1) / 2) * shiftStep;
+    }
+
+    placed[node] = true;
+    insertInGrid(node);
+    maxX = qMax(maxX, box.x + box.width / 2);
+  }
+}
+
+
+void GraphLayout::normalize(void)
+{
+  double minX = std::numeric_limits<double>::max();
+  double minY = std::numeric_limits<double>::max();
+  double maxX = std::numeric_limits<double>::lowest();
+  double maxY = std::numeric_limits<double>::lowest();
+  for (const auto& box: m_boxes) {
+    minX = qMin(minX, box.x - box.width / 2);
+    minY = qMin(minY, box.y - box.height / 2);
+    maxX = qMax(maxX, box.x + box.width / 2);
+    maxY = qMax(maxY, box.y + box.height / 2);
+  }
+
+  for (auto& box: m_boxes) {
+    box.x -= minX;
+    box.y -= minY;
+  }
+  m_width = maxX - minX;
+  m_height = maxY - minY;
+}
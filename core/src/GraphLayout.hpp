@@ -0,0 +1,78 @@
+/*
+ * GraphLayout.hpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#ifndef GRAPHLAYOUT_HPP
+#define GRAPHLAYOUT_HPP
+
+#include "Base.hpp"
+#include <QVector>
+
+
+/**
+ * @brief In-process layout of service graphs.
+ * Produces the same kind of output graphviz used to produce (node centers and label boxes in inches,
+ * parents above their children), using a layered layout for ngrt4n::DotLayout
+ * and a radial layout for ngrt4n::NeatoLayout. Both run in O((V + E) log V) time in the size of the graph,
+ * and need neither temporary files nor external processes.
+ * When some nodes are pinned, only the other ones are placed, next to their already placed relatives.
+ */
+class GraphLayout
+{
+public:
+  struct NodeBoxT {
+    double x = 0;
+    double y = 0;
+    double width = 0;
+    double height = 0;
+  };
+
+  GraphLayout(int layoutType);
+  void addNode(const QString& id, const QString& label);
+  void addEdge(const QString& parentId, const QString& childId);
+  void pinNode(const QString& id, double x, double y);
+  void run(void);
+  NodeBoxT box(const QString& id) const;
+  double width(void) const {return m_width;}
+  double height(void) const {return m_height;}
+
+private:
+  int m_layoutType;
+  QHash<QString, int> m_indexes;
+  QVector<NodeBoxT> m_boxes;
+  QVector<QVector<int>> m_children;
+  QVector<QVector<int>> m_parents;
+  QVector<bool> m_pinned;
+  int m_pinnedCount;
+  double m_width;
+  double m_height;
+
+  QVector<int> computeRanks(void) const;
+  void runLayeredLayout(const QVector<int>& ranks);
+  void runRadialLayout(const QVector<int>& ranks);
+  void runIncrementalLayout(const QVector<int>& ranks);
+  void placeLayer(const QVector<int>& layer, const QVector<double>& desiredX);
+  void normalize(void);
+};
+
+#endif // GRAPHLAYOUT_HPP
@@ -326,7 +326,7 @@ std::pair<QString, int> K8sHelper::parseNamespacedPods(const QByteArray& in_data
     auto&& podPhaseStatus = podStatusData["phase"].toString();
     auto podStatusConditions = podStatusData["conditions"].toArray();
     const auto StatusPhase = convertToPodPhaseStatusEnum(podPhaseStatus);
-
+    CheckT podCheck;
 
     switch (StatusPhase) {
     // handle Failed and CrashLoopBackoff pods as IT services
@@ -334,12 +334,13 @@ std::pair<QString, int> K8sHelper::parseNamespacedPods(const QByteArray& in_data
     case ngrt4n::K8sPodPhaseCrashLoopBackoff:
       podNode.type = NodeType::ITService;
       podNode.child_nodes = podFqdn;
-      podNode.check.id = podNode.child_nodes.toStdString();
-      podNode.check.host = podFqdn.toStdString();
-      podNode.check.host_groups = podFqdn.toStdString();
-      podNode.check.status = ngrt4n::K8sFailed;
-      podNode.check.last_state_change = ngrt4n::convertToTimet(podCreationTime, "yyyy-MM-ddThh:mm:ssZ");
-      podNode.check.alarm_msg = QString("pod is %1 because %2 (%3)").arg(podPhaseStatus, podStatusData["reason"].toString(), podStatusData["message"].toString()).toLower().toStdString();
+      podCheck.id = podNode.child_nodes.toStdString();
+      podCheck.host = podFqdn.toStdString();
+      podCheck.host_groups = podFqdn.toStdString();
+      podCheck.status = ngrt4n::K8sFailed;
+      podCheck.last_state_change = ngrt4n::convertToTimet(podCreationTime, "yyyy-MM-ddThh:mm:ssZ");
+      podCheck.alarm_msg = QString("pod is %1 because %2 (%3)").arg(podPhaseStatus, podStatusData["reason"].toString(), podStatusData["message"].toString()).toLower().toStdString();
+      podNode.check = podCheck;
       out_cnodes.insert(podNode.id, podNode);
       continue; // since there is not containerStatuses object to process
       break;
@@ -347,20 +348,21 @@ std::pair<QString, int> K8sHelper::parseNamespacedPods(const QByteArray& in_data
     case ngrt4n::K8sPodPhasePending:
       podNode.type = NodeType::ITService;
       podNode.child_nodes = podFqdn;
-      podNode.check.id = podNode.child_nodes.toStdString();
-      podNode.check.host = podFqdn.toStdString();
-      podNode.check.host_groups = podFqdn.toStdString();
-      podNode.check.status = ngrt4n::K8sFailed;
+      podCheck.id = podNode.child_nodes.toStdString();
+      podCheck.host = podFqdn.toStdString();
+      podCheck.host_groups = podFqdn.toStdString();
+      podCheck.status = ngrt4n::K8sFailed;
 
       if (! podStatusConditions.empty()) {
         auto lastStatusCondition = podStatusConditions[0].toObject();
-        podNode.check.last_state_change = ngrt4n::convertToTimet(lastStatusCondition["lastTransitionTime"].toString(), "yyyy-MM-ddThh:mm:ssZ");
-        podNode.check.alarm_msg = QString("pod is %1 because %2 (%3)").arg(podPhaseStatus, lastStatusCondition["reason"].toString(), lastStatusCondition["message"].toString()).toLower().toStdString();
+        podCheck.last_state_change = ngrt4n::convertToTimet(lastStatusCondition["lastTransitionTime"].toString(), "yyyy-MM-ddThh:mm:ssZ");
+        podCheck.alarm_msg = QString("pod is %1 because %2 (%3)").arg(podPhaseStatus, lastStatusCondition["reason"].toString(), lastStatusCondition["message"].toString()).toLower().toStdString();
       } else { // unexpected situation
-        podNode.check.last_state_change = "0";
-        podNode.check.alarm_msg = "cannot get condition for pending state";
+        podCheck.last_state_change = "0";
+        podCheck.alarm_msg = "cannot get condition for pending state";
       }
 
+      podNode.check = podCheck;
       out_cnodes.insert(podNode.id, podNode);
       break;
     case ngrt4n::K8sPodPhaseRunning:
@@ -395,17 +397,18 @@ std::pair<QString, int> K8sHelper::parseNamespacedPods(const QByteArray& in_data
       containerNode.name = containerName;
       containerNode.description = QString("Ready -> %1, restartCount -> %2").arg(ready ? "true" : "false").arg(restartCount);
       containerNode.child_nodes = QString("%1/%2").arg(podFqdn, containerName);
-      containerNode.check.id = containerNode.child_nodes.toStdString();
-      containerNode.check.host = containerName.toStdString();
-      containerNode.check.host_groups = podFqdn.toStdString();
+      auto& containerCheck = containerNode.check.edit();
+      containerCheck.id = containerNode.child_nodes.toStdString();
+      containerCheck.host = containerName.toStdString();
+      containerCheck.host_groups = podFqdn.toStdString();
 
-      std::tie(containerNode.check.status,
-               containerNode.check.last_state_change,
-               containerNode.check.alarm_msg) = extractStateInfo(containerStatusData["state"].toObject());
+      std::tie(containerCheck.status,
+               containerCheck.last_state_change,
+               containerCheck.alarm_msg) = extractStateInfo(containerStatusData["state"].toObject());
 
       // format timestamp as seconds since epoch
-      containerNode.check.last_state_change = ngrt4n::convertToTimet(
-            (containerNode.check.last_state_change.empty()? podCreationTime : containerNode.check.last_state_change.c_str()),
+      containerCheck.last_state_change = ngrt4n::convertToTimet(
+            (containerCheck.last_state_change.empty()? podCreationTime : containerCheck.last_state_change.c_str()),
             "yyyy-MM-ddThh:mm:ssZ");
 
       // add container node as IT service
@@ -0,0 +1,253 @@
+/*
+ * LayoutCache.cpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#include "LayoutCache.hpp"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QDebug>
+#include <atomic>
+
+
+LayoutCache::LayoutCache(const QString& cacheDir)
+  : m_cacheDir(cacheDir)
+{
+}
+
+
+QByteArray LayoutCache::topologyHash(const CoreDataT& cdata, int graphLayout)
+{
+  QStringList nodeEntries;
+  QStringList edgeEntries;
+  auto addNodeEntries = [&nodeEntries, &edgeEntries](const NodeListT& nodes) {
+    for (const auto& node: nodes) {
+      nodeEntries.push_back(QString("%1\t%2").arg(node.id, node.name));
+      for (const auto& parentId: node.parents) {
+        edgeEntries.push_back(QString("%1\t%2").arg(parentId, node.id));
+      }
+    }
+  };
+  addNodeEntries(cdata.bpnodes);
+  addNodeEntries(cdata.cnodes);
+  nodeEntries.sort();
+  edgeEntries.sort();
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(QString("layout=%1\n").arg(graphLayout).toUtf8());
+  hash.addData(nodeEntries.join("\n").toUtf8());
+  hash.addData("\n--\n");
+  hash.addData(edgeEntries.join("\n").toUtf8());
+
+  return hash.result().toHex();
+}
+
+
+bool LayoutCache::load(const QByteArray& hash, CoreDataT& cdata) const
+{
+  QFile file(entryPath(hash));
+  if (! file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  QDataStream in(&file);
+  qint32 formatVersion;
+  qint8 graphMode;
+  double minX, minY, mapWidth, mapHeight;
+  qint32 nodeCount;
+  in >> formatVersion;
+  if (formatVersion != FORMAT_VERSION) {
+    return false;
+  }
+  in >> graphMode >> minX >> minY >> mapWidth >> mapHeight >> nodeCount;
+  if (in.status() != QDataStream::Ok || nodeCount != cdata.bpnodes.size() + cdata.cnodes.size()) {
+    return false;
+  }
+
+  // positions are first read aside, so that a truncated or mismatching entry leaves cdata untouched
+  QHash<QString, QVector<double>> positions;
+  positions.reserve(nodeCount);
+  for (qint32 index = 0; index < nodeCount; ++index) {
+    QString nodeId;
+    QVector<double> position(4);
+    in >> nodeId >> position[0] >> position[1] >> position[2] >> position[3];
+    positions.insert(nodeId, position);
+  }
+  if (in.status() != QDataStream::Ok) {
+    return false;
+  }
+
+  for (auto nodes: {&cdata.bpnodes, &cdata.cnodes}) {
+    for (const auto& node: *nodes) {
+      if (! positions.contains(node.id)) {
+        return false;
+      }
+    }
+  }
+
+  for (auto nodes: {&cdata.bpnodes, &cdata.cnodes}) {
+    for (auto& node: *nodes) {
+      const auto& position = positions[node.id];
+      node.pos_x = position[0];
+      node.pos_y = position[1];
+      node.text_w = position[2];
+      node.text_h = position[3];
+    }
+  }
+  cdata.graph_mode = graphMode;
+  cdata.min_x = minX;
+  cdata.min_y = minY;
+  cdata.map_width = mapWidth;
+  cdata.map_height = mapHeight;
+  markUsed(file);
+
+  return true;
+}
+
+
+void LayoutCache::save(const QByteArray& hash, const CoreDataT& cdata) const
+{
+  if (! QDir().mkpath(m_cacheDir)) {
+    qDebug() << QObject::tr("Cannot create layout cache directory: %1").arg(m_cacheDir);
+    return;
+  }
+
+  // written aside then renamed, concurrent readers never see a partial entry
+  QSaveFile file(entryPath(hash));
+  if (! file.open(QIODevice::WriteOnly)) {
+    qDebug() << QObject::tr("Cannot write layout cache entry: %1").arg(file.fileName());
+    return;
+  }
+
+  QDataStream out(&file);
+  out << FORMAT_VERSION
+      << cdata.graph_mode
+      << cdata.min_x
+      << cdata.min_y
+      << cdata.map_width
+      << cdata.map_height
+      << static_cast<qint32>(cdata.bpnodes.size() + cdata.cnodes.size());
+  for (auto nodes: {&cdata.bpnodes, &cdata.cnodes}) {
+    for (const auto& node: *nodes) {
+      out << node.id << node.pos_x << node.pos_y << node.text_w << node.text_h;
+    }
+  }
+
+  if (! file.commit()) {
+    qDebug() << QObject::tr("Cannot write layout cache entry: %1").arg(file.fileName());
+    return;
+  }
+
+  pruneExpiredEntries();
+}
+
+
+bool LayoutCache::loadLatestPositions(const QString& viewFile, int graphLayout, PositionListT& positions) const
+{
+  QFile file(latestPositionsPath(viewFile));
+  if (! file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  QDataStream in(&file);
+  qint32 formatVersion;
+  qint32 savedGraphLayout;
+  in >> formatVersion >> savedGraphLayout;
+  if (formatVersion != FORMAT_VERSION || savedGraphLayout != graphLayout) {
+    return false;
+  }
+  in >> positions;
+  if (in.status() != QDataStream::Ok) {
+    return false;
+  }
+  markUsed(file);
+
+  return true;
+}
+
+
+void LayoutCache::saveLatestPositions(const QString& viewFile, int graphLayout, const PositionListT& positions) const
+{
+  if (! QDir().mkpath(m_cacheDir)) {
+    qDebug() << QObject::tr("Cannot create layout cache directory: %1").arg(m_cacheDir);
+    return;
+  }
+
+  QSaveFile file(latestPositionsPath(viewFile));
+  if (! file.open(QIODevice::WriteOnly)) {
+    qDebug() << QObject::tr("Cannot write layout cache entry: %1").arg(file.fileName());
+    return;
+  }
+
+  QDataStream out(&file);
+  out << FORMAT_VERSION << static_cast<qint32>(graphLayout) << positions;
+  if (! file.commit()) {
+    qDebug() << QObject::tr("Cannot write layout cache entry: %1").arg(file.fileName());
+  }
+}
+
+
+QString LayoutCache::entryPath(const QByteArray& hash) const
+{
+  return QString("%1/%2.layout").arg(m_cacheDir, QString::fromLatin1(hash));
+}
+
+
+QString LayoutCache::latestPositionsPath(const QString& viewFile) const
+{
+  auto viewHash = QCryptographicHash::hash(viewFile.toUtf8(), QCryptographicHash::Sha1).toHex();
+  return QString("%1/%2.latest").arg(m_cacheDir, QString::fromLatin1(viewHash));
+}
+
+
+/**
+ * Refreshes the modification time of an entry in use, at most once a day, so that it isn't pruned.
+ */
+void LayoutCache::markUsed(QFile& file)
+{
+  const auto now = QDateTime::currentDateTime();
+  if (file.fileTime(QFileDevice::FileModificationTime) < now.addDays(-1)) {
+    file.setFileTime(now, QFileDevice::FileModificationTime);
+  }
+}
+
+
+void LayoutCache::pruneExpiredEntries(void) const
+{
+  static std::atomic<qint64> lastPruneTime(0);
+  const qint64 now = QDateTime::currentSecsSinceEpoch();
+  qint64 lastTime = lastPruneTime.load();
+  if (now - lastTime < PRUNE_INTERVAL || ! lastPruneTime.compare_exchange_strong(lastTime, now)) {
+    return;
+  }
+
+  const auto expiryDate = QDateTime::currentDateTime().addDays(-ENTRY_MAX_AGE_DAYS);
+  for (const auto& entry: QDir(m_cacheDir).entryInfoList(QStringList() << "*.layout" << "*.latest", QDir::Files)) {
+    if (entry.lastModified() < expiryDate) {
+      QFile::remove(entry.absoluteFilePath());
+    }
+  }
+}
@@ -0,0 +1,64 @@
+/*
+ * LayoutCache.hpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#ifndef LAYOUTCACHE_HPP
+#define LAYOUTCACHE_HPP
+
+#include "Base.hpp"
+#include <QPointF>
+
+
+/**
+ * @brief On-disk cache of map layouts.
+ * Entries hold node positions, text sizes and map dimensions. They are keyed by a hash of the view
+ * topology (node ids and labels, parent/child links) and of the layout engine, so that only views
+ * whose structure has changed need a new layout. Entries are shared by all sessions and processes.
+ * The latest raw positions of each dynamic view are also kept, so that their next layout can pin surviving nodes.
+ * Entries unused for ENTRY_MAX_AGE_DAYS are pruned, loads refresh their modification time.
+ */
+class LayoutCache
+{
+public:
+  static const qint32 FORMAT_VERSION = 1;
+  static const qint32 ENTRY_MAX_AGE_DAYS = 30;
+  static const qint64 PRUNE_INTERVAL = 3600; // seconds, per process
+  typedef QHash<QString, QPointF> PositionListT;
+
+  LayoutCache(const QString& cacheDir);
+  static QByteArray topologyHash(const CoreDataT& cdata, int graphLayout);
+  bool load(const QByteArray& hash, CoreDataT& cdata) const;
+  void save(const QByteArray& hash, const CoreDataT& cdata) const;
+  bool loadLatestPositions(const QString& viewFile, int graphLayout, PositionListT& positions) const;
+  void saveLatestPositions(const QString& viewFile, int graphLayout, const PositionListT& positions) const;
+
+private:
+  QString m_cacheDir;
+
+  QString entryPath(const QByteArray& hash) const;
+  QString latestPositionsPath(const QString& viewFile) const;
+  void pruneExpiredEntries(void) const;
+  static void markUsed(QFile& file);
+};
+
+#endif // LAYOUTCACHE_HPP
@@ -26,12 +26,26 @@
 #include "utilsCore.hpp"
 #include "ThresholdHelper.hpp"
 #include "K8sHelper.hpp"
+#include "GraphLayout.hpp"
+#include "LayoutCache.hpp"
+#include "CompiledView.hpp"
 #include <QObject>
-#include <QtXml>
+#include <QXmlStreamReader>
+#include <QFile>
+#include <QDebug>
 #include <iostream>
 #include <cassert>
 
 
+namespace {
+  // dynamic view items may get new ids from one load to another, their data points don't change
+  QString layoutKey(const NodeT& node)
+  {
+    return (node.type == NodeType::ITService && ! node.child_nodes.isEmpty()) ? node.child_nodes : node.id;
+  }
+} // namespace
+
+
 Parser::Parser(CoreDataT* _cdata, int _parsingMode, DbSession* dbSession)
   : m_cdata(_cdata),
     m_parsingMode(_parsingMode),
@@ -42,20 +56,14 @@ Parser::Parser(CoreDataT* _cdata, int _parsingMode, DbSession* dbSession)
 
 Parser::~Parser()
 {
-  QFile fileHandler;
-  if (fileHandler.exists(m_plainFile)) {
-    fileHandler.remove(m_plainFile);
-  }
-  if (fileHandler.exists(m_dotFile) && m_lastErrorMsg.isEmpty()) {
-    fileHandler.remove(m_dotFile);
-  }
-  fileHandler.close();
 }
 
 int Parser::processRenderingData(void)
 {
+  if (m_parsingMode == ParsingModeCollector) {
+    return ngrt4n::RcSuccess;
+  }
   fixupVisilityAndDependenciesGraph();
-  saveCoordinatesFile();
   return computeCoordinates();
 }
 
@@ -66,62 +74,45 @@ std::pair<int, QString> Parser::parse(const QString& viewFile)
   }
 
   m_cdata->clear();
-  QDomDocument xmlDoc;
-  QDomElement xmlRoot;
+  m_viewFile = viewFile;
+  CompiledView compiledView(SettingFactory::coreCompiledViewDir(), viewFile, m_parsingMode);
+  if (compiledView.load(*m_cdata)) {
+    return std::make_pair(ngrt4n::RcSuccess, "");
+  }
+
   QFile file(viewFile);
   if (! file.open(QIODevice::ReadOnly|QIODevice::Text)) {
     file.close();
     return std::make_pair(ngrt4n::RcGenericFailure, QObject::tr("Unable to open the file %1").arg(viewFile));
   }
 
-  if (! xmlDoc.setContent(&file)) {
-    file.close();
+  // single pass over the file, nodes are built as their elements are read
+  QXmlStreamReader xmlReader(&file);
+  if (! xmlReader.readNextStartElement()) {
     return std::make_pair(ngrt4n::RcGenericFailure, QObject::tr("Error while parsing the file %1").arg(viewFile));
   }
 
-  file.close(); // The content of the file is already in memory
-
-  xmlRoot = xmlDoc.documentElement();
-  m_cdata->monitor = static_cast<qint8>(xmlRoot.attribute("monitor").toInt());
-  m_cdata->format_version = xmlRoot.attribute("compat").toDouble();
-
-  QDomNodeList xmlNodes = xmlRoot.elementsByTagName("Service");
+  m_cdata->monitor = static_cast<qint8>(xmlReader.attributes().value("monitor").toInt());
+  m_cdata->format_version = xmlReader.attributes().value("compat").toDouble();
 
-  if (m_cdata->monitor != MonitorT::Any) {
-    return loadDynamicViewByGroup(xmlNodes, *m_cdata);
-  }
-
-  qint32 xmlNodeCount = xmlNodes.size();
-  for (qint32 nodeIndex = 0; nodeIndex < xmlNodeCount; ++nodeIndex) {
-    QDomElement xmlNode = xmlNodes.item(nodeIndex).toElement();
-    NodeT node;
-    node.parents.clear();
-    node.monitored = false;
-    node.id = xmlNode.attribute("id").trimmed();
-    node.sev = ngrt4n::Unknown;
-    node.sev_prop = ngrt4n::Unknown;
-    node.sev_crule = xmlNode.attribute("statusCalcRule").toInt();
-    node.sev_prule = xmlNode.attribute("statusPropRule").toInt();
-    node.icon = xmlNode.firstChildElement("Icon").text().trimmed();
-    node.name = ngrt4n::decodeXml( xmlNode.firstChildElement("Name").text().trimmed() );
-    node.description = ngrt4n::decodeXml( xmlNode.firstChildElement("Description").text().trimmed() );
-    node.alarm_msg = ngrt4n::decodeXml( xmlNode.firstChildElement("AlarmMsg").text().trimmed() );
-    node.notification_msg = ngrt4n::decodeXml( xmlNode.firstChildElement("NotificationMsg").text().trimmed() );
-    node.child_nodes = ngrt4n::decodeXml( xmlNode.firstChildElement("SubServices").text().trimmed() );
-    node.weight = (m_cdata->format_version >= 3.1) ? xmlNode.attribute("weight").toDouble() : ngrt4n::WEIGHT_UNIT;
-
-    if (node.sev_crule == CalcRules::WeightedAverageWithThresholds) {
-      QString thdata = xmlNode.firstChildElement("Thresholds").text().trimmed();
-      node.thresholdLimits = ThresholdHelper::dataToList(thdata);
-      std::sort(node.thresholdLimits.begin(), node.thresholdLimits.end(), ThresholdLessthanFnt());
+  // Service elements are looked up at any depth below the root, as the former DOM lookup by tag name did
+  qint32 xmlNodeCount = 0;
+  NodeT dynamicViewRootNode;
+  while (! xmlReader.atEnd()) {
+    if (xmlReader.readNext() != QXmlStreamReader::StartElement || xmlReader.name() != QLatin1String("Service")) {
+      continue;
     }
 
-    node.check.status = -1;
-    if (node.icon.isEmpty()) {
-      node.icon = ngrt4n::DEFAULT_ICON;
+    ++xmlNodeCount;
+    NodeT node;
+    readServiceElement(xmlReader, node);
+    if (m_cdata->monitor != MonitorT::Any) {
+      if (xmlNodeCount == 1) {
+        dynamicViewRootNode = node;
+      }
+      continue;
     }
 
-    node.type = xmlNode.attribute("type").toInt();
     switch(node.type) {
       case NodeType::ITService:
         insertITServiceNode(node);
@@ -134,6 +125,20 @@ std::pair<int, QString> Parser::parse(const QString& viewFile)
     }
   }
 
+  file.close();
+
+  if (xmlReader.hasError()) {
+    return std::make_pair(ngrt4n::RcGenericFailure, QObject::tr("Error while parsing the file %1 (line %2: %3)")
+                          .arg(viewFile, QString::number(xmlReader.lineNumber()), xmlReader.errorString()));
+  }
+
+  if (m_cdata->monitor != MonitorT::Any) {
+    if (xmlNodeCount != 1) {
+      return std::make_pair(ngrt4n::RcParseError, QObject::tr("unexpected number of items for dynamic view: %1").arg(xmlNodeCount));
+    }
+    return loadDynamicViewByGroup(dynamicViewRootNode.id, dynamicViewRootNode.name, *m_cdata);
+  }
+
   // set nodes' parents
   for (const auto& bpnode: m_cdata->bpnodes) {
     for (const auto& childId: bpnode.child_nodes.split(ngrt4n::CHILD_Q_SEP)) {
@@ -144,20 +149,71 @@ std::pair<int, QString> Parser::parse(const QString& viewFile)
     }
   }
 
+  // dynamic views are never compiled, their content comes from the monitoring sources
+  compiledView.save(*m_cdata);
+
   return std::make_pair(ngrt4n::RcSuccess, "");
 }
 
 
-std::pair<int, QString> Parser::loadDynamicViewByGroup(QDomNodeList& inXmlDomNodes, CoreDataT& outCData)
+void Parser::readServiceElement(QXmlStreamReader& xmlReader, NodeT& node)
 {
-  if (inXmlDomNodes.size() != 1) {
-    return std::make_pair(ngrt4n::RcParseError, QObject::tr("unexpected number of items for dynamic view: %1").arg(inXmlDomNodes.size()));
+  // the stream reader already resolves XML entities, decodeXml is only kept for legacy double-encoded content
+  auto readText = [&xmlReader]() {
+    QString text = xmlReader.readElementText().trimmed();
+    return text.contains('&') ? ngrt4n::decodeXml(text) : text;
+  };
+
+  const auto attributes = xmlReader.attributes();
+  node.parents.clear();
+  node.monitored = false;
+  node.id = attributes.value("id").toString().trimmed();
+  node.sev = ngrt4n::Unknown;
+  node.sev_prop = ngrt4n::Unknown;
+  node.sev_crule = attributes.value("statusCalcRule").toInt();
+  node.sev_prule = attributes.value("statusPropRule").toInt();
+  node.weight = (m_cdata->format_version >= 3.1) ? attributes.value("weight").toDouble() : ngrt4n::WEIGHT_UNIT;
+  node.type = attributes.value("type").toInt();
+
+  QString thdata;
+  while (xmlReader.readNextStartElement()) {
+    const auto elementName = xmlReader.name();
+    if (elementName == QLatin1String("Name")) {
+      node.name = readText();
+    } else if (elementName == QLatin1String("AlarmMsg")) {
+      node.alarm_msg = readText();
+    } else if (elementName == QLatin1String("NotificationMsg")) {
+      node.notification_msg = readText();
+    } else if (elementName == QLatin1String("SubServices")) {
+      node.child_nodes = readText();
+    } else if (elementName == QLatin1String("Thresholds")) {
+      thdata = xmlReader.readElementText().trimmed();
+    } else if (m_parsingMode != ParsingModeCollector && elementName == QLatin1String("Icon")) {
+      node.icon = xmlReader.readElementText().trimmed();
+    } else if (m_parsingMode != ParsingModeCollector && elementName == QLatin1String("Description")) {
+      node.description = readText();
+    } else if (elementName == QLatin1String("Service")) {
+      // children are referenced through SubServices, a nested element would be silently lost
+      xmlReader.raiseError(QObject::tr("nested Service element in service %1").arg(node.id));
+    } else {
+      xmlReader.skipCurrentElement();
+    }
   }
 
-  QDomElement xmlRootNode = inXmlDomNodes.item(0).toElement();
-  QString sourceId = xmlRootNode.attribute("id").trimmed();
-  QString monitoredGroup = xmlRootNode.firstChildElement("Name").text().trimmed();
+  if (node.sev_crule == CalcRules::WeightedAverageWithThresholds) {
+    node.thresholdLimits = ThresholdHelper::dataToList(thdata);
+    std::sort(node.thresholdLimits.begin(), node.thresholdLimits.end(), ThresholdLessthanFnt());
+  }
+
+  node.check = CheckRefT(); // shared empty check, status -1
+  if (node.icon.isEmpty()) {
+    node.icon = ngrt4n::DEFAULT_ICON;
+  }
+}
+
 
+std::pair<int, QString> Parser::loadDynamicViewByGroup(const QString& sourceId, const QString& monitoredGroup, CoreDataT& outCData)
+{
   outCData.sources.insert(sourceId);
 
   auto sourceFound = m_dbSession->findSourceById(sourceId);
@@ -184,161 +240,106 @@ std::pair<int, QString> Parser::loadDynamicViewByGroup(QDomNodeList& inXmlDomNod
 }
 
 
-QString Parser::escapeLabel4Graphviz(const QString& label)
-{
-  QString rwLabel = label;
-  return rwLabel.replace("'", " ").replace("-", " ").replace("\"", " ").replace(' ', '#').replace(';', '_').replace('&', '_').replace('$', '_');
-}
-
-QString Parser::escapeId4Graphviz(const QString& id)
-{
-  QString rwId = id;
-  return rwId.replace("'", " ").replace("-", "_").replace("\"", "_").replace(' ', '_').replace('#', '_');
-}
-
-
-
 void Parser::fixupVisilityAndDependenciesGraph(void)
 {
-  m_dotContent = "\n";
-
   for (auto&& bpnode:  m_cdata->bpnodes) {
     bpnode.visibility = ngrt4n::Visible|ngrt4n::Expanded;
-    auto bpnodeGraphId = escapeId4Graphviz(bpnode.id);
-    m_dotContent.insert(0, QString("\t%1[label=\"%2\"];\n").arg(bpnodeGraphId, escapeLabel4Graphviz(bpnode.name)));
-    bindGraphDependencies(bpnode);
   }
 
-  // Set IT service nodes' labels
   for (auto&& cnode: m_cdata->cnodes) {
     cnode.visibility = ngrt4n::Visible;
-    m_dotContent.insert(0, QString("\t%1[label=\"%2\"];\n").arg(escapeId4Graphviz(cnode.id), escapeLabel4Graphviz(cnode.name)));
-    bindGraphDependencies(cnode);
   }
 }
 
-void Parser::bindGraphDependencies(const NodeT& node)
-{
-  m_dotContent.append( QString("\tedge [len=%1]\n").arg(NEATO_EDGE_LENGTH) );
-
-  auto nodeGraphId = escapeId4Graphviz(node.id);
-  for (const auto& parentId: node.parents) {
-    NodeListT::Iterator parentRef;
-    if (ngrt4n::findNode(m_cdata, parentId, parentRef)) {
-      m_dotContent.append(QString("\t%1--%2\n").arg(escapeId4Graphviz(parentId), nodeGraphId));
-    } else {
-      if (node.id != ngrt4n::ROOT_ID) {
-        qDebug() << QObject::tr("Failed to find parent-child dependency '%1' => %2").arg(parentId, node.id);
-      }
-    }
-  }
-}
-
-
-void Parser::saveCoordinatesFile(void)
-{
-  m_dotFile = QDir::tempPath()%"/realopinsight-gen-"%QTime().currentTime().toString("hhmmsszzz")%".dot";
-  m_plainFile = m_dotFile % ".plain";
-  QFile file(m_dotFile);
-  if (! file.open(QIODevice::WriteOnly|QIODevice::Text)) {
-    m_lastErrorMsg = QObject::tr("Unable into write file %1").arg(m_dotFile);
-    file.close();
-    exit(1);
-  }
-  QTextStream fstream(&file);
-  fstream << "strict graph\n{\n node[shape=plaintext]\n"
-          << m_dotContent
-          << "}";
-  file.close();
-}
 
 int Parser::computeCoordinates(void)
 {
-  QProcess process;
-  QStringList arguments = QStringList() << "-Tplain"<< "-o" << m_plainFile << m_dotFile;
-
-  int exitCode = -2;
   SettingFactory settings;
-  switch (settings.getGraphLayout()) {
-    case ngrt4n::DotLayout:
-      exitCode = process.execute("dot", arguments);
-      break;
-    case ngrt4n::NeatoLayout: //use dot as default
-    default:
-      exitCode = process.execute("neato", arguments);
-      break;
+  const int graphLayout = settings.getGraphLayout();
+  GraphLayout layout(graphLayout);
+  for (const auto& bpnode: m_cdata->bpnodes) {
+    layout.addNode(bpnode.id, bpnode.name);
   }
-
-  process.waitForFinished(60000);
-  if (exitCode != 0) {
-    m_lastErrorMsg = QObject::tr("The graph engine exited on error (code: %1, file: %2").arg(QString::number(exitCode), m_dotFile);
-    return ngrt4n::RcGenericFailure;
+  for (const auto& cnode: m_cdata->cnodes) {
+    layout.addNode(cnode.id, cnode.name);
   }
 
-  QFile qfile(m_plainFile);
-  if (! qfile.open(QFile::ReadOnly)) {
-    m_lastErrorMsg = QObject::tr("Failed to open file: %1").arg(m_plainFile);
-    return ngrt4n::RcGenericFailure;
+  m_cdata->edges.clear();
+  auto bindGraphDependencies = [this, &layout](const NodeT& node) {
+    for (const auto& parentId: node.parents) {
+      NodeListT::Iterator parentRef;
+      if (ngrt4n::findNode(m_cdata, parentId, parentRef)) {
+        layout.addEdge(parentId, node.id);
+        // multiInsert because a node can have several childs
+        m_cdata->edges.insertMulti(parentId, node.id);
+      } else if (node.id != ngrt4n::ROOT_ID) {
+        qDebug() << QObject::tr("Failed to find parent-child dependency '%1' => %2").arg(parentId, node.id);
+      }
+    }
+  };
+  for (const auto& bpnode: m_cdata->bpnodes) {
+    bindGraphDependencies(bpnode);
   }
-
-  //start parsing
-  QTextStream coodFileStream(& qfile);
-  QString line;
-  if(static_cast<void>(line = coodFileStream.readLine(0)), line.isNull()) {
-    m_lastErrorMsg = QObject::tr("Failed to read file: %1").arg(m_plainFile);
-    return ngrt4n::RcGenericFailure;
+  for (const auto& cnode: m_cdata->cnodes) {
+    bindGraphDependencies(cnode);
   }
 
-  QRegExp regexSep("[ ]+");
-  QStringList splitedLine = line.split (regexSep);
-  if (splitedLine.size() != 4 || splitedLine[0] != "graph") {
-    m_lastErrorMsg = QObject::tr("Invalid graphviz entry: %1").arg(line);
-    return ngrt4n::RcGenericFailure;
+  LayoutCache layoutCache(SettingFactory::coreLayoutCacheDir());
+  QByteArray topologyHash;
+  const bool isDynamicView = (m_cdata->monitor != MonitorT::Any);
+  if (isDynamicView) {
+    // items come and go in dynamic views: keep the surviving ones where they were and only place the new ones
+    LayoutCache::PositionListT latestPositions;
+    if (layoutCache.loadLatestPositions(m_viewFile, graphLayout, latestPositions)) {
+      for (auto nodes: {&m_cdata->bpnodes, &m_cdata->cnodes}) {
+        for (const auto& node: *nodes) {
+          auto position = latestPositions.constFind(layoutKey(node));
+          if (position != latestPositions.cend()) {
+            layout.pinNode(node.id, position->x(), position->y());
+          }
+        }
+      }
+    }
+  } else {
+    topologyHash = LayoutCache::topologyHash(*m_cdata, graphLayout);
+    if (layoutCache.load(topologyHash, *m_cdata)) {
+      return ngrt4n::RcSuccess;
+    }
   }
 
-  const ScaleFactors SCALE_FACTORS(settings.getGraphLayout());
-  m_cdata->graph_mode = static_cast<qint8>(settings.getGraphLayout());
-  auto maxWidthRaw = splitedLine[2].trimmed().toDouble();
+  layout.run();
+
+  const ScaleFactors SCALE_FACTORS(graphLayout);
+  m_cdata->graph_mode = static_cast<qint8>(graphLayout);
+  auto maxWidthRaw = layout.width();
   m_cdata->map_width = maxWidthRaw * SCALE_FACTORS.x() + NEATO_X_TRANSLATION_FACTOR * maxWidthRaw;
-  m_cdata->map_height = splitedLine[3].trimmed().toDouble() * SCALE_FACTORS.y();
+  m_cdata->map_height = layout.height() * SCALE_FACTORS.y();
   m_cdata->min_x = 0;
   m_cdata->min_y = 0;
   double max_text_w = 0;
   double max_text_h = 0;
 
-  int x_index = 2;
-  int y_index = 3;
-
-  while (static_cast<void>(line = coodFileStream.readLine(0)), ! line.isNull()) {
-    splitedLine = line.split (regexSep);
-    if (splitedLine[0] == "node") {
-      NodeListT::Iterator node;
-      QString nid = splitedLine[1].trimmed();
-      if (ngrt4n::findNode(m_cdata, nid, node)) {
-        auto posXRaw = splitedLine[x_index].trimmed().toDouble();
-        node->pos_x =  posXRaw * SCALE_FACTORS.x() + NEATO_X_TRANSLATION_FACTOR * posXRaw;
-        node->pos_y = splitedLine[y_index].trimmed().toDouble() * SCALE_FACTORS.y();
-
-        node->text_w = splitedLine[4].trimmed().toDouble() * SCALE_FACTORS.x();
-        node->text_h = splitedLine[5].trimmed().toDouble() * SCALE_FACTORS.y();
-
-        m_cdata->min_x = qMin<double>(m_cdata->min_x, node->pos_x);
-        m_cdata->min_y = qMin<double>(m_cdata->min_y, node->pos_y);
-
-        max_text_w = qMax(max_text_w, node->text_w);
-        max_text_h = qMax(max_text_h, node->text_h);
-      }
-    } else if (splitedLine[0] == "edge") {
-      // multiInsert because a node can have several childs
-      m_cdata->edges.insertMulti(splitedLine[1], splitedLine[2]);
-    } else if (splitedLine[0] == "stop") {
-      break;
-    }
+  auto setNodeCoordinates = [&](NodeT& node) {
+    auto box = layout.box(node.id);
+    node.pos_x = box.x * SCALE_FACTORS.x() + NEATO_X_TRANSLATION_FACTOR * box.x;
+    node.pos_y = box.y * SCALE_FACTORS.y();
+    node.text_w = box.width * SCALE_FACTORS.x();
+    node.text_h = box.height * SCALE_FACTORS.y();
+
+    m_cdata->min_x = qMin<double>(m_cdata->min_x, node.pos_x);
+    m_cdata->min_y = qMin<double>(m_cdata->min_y, node.pos_y);
+
+    max_text_w = qMax(max_text_w, node.text_w);
+    max_text_h = qMax(max_text_h, node.text_h);
+  };
+  for (auto& bpnode: m_cdata->bpnodes) {
+    setNodeCoordinates(bpnode);
+  }
+  for (auto& cnode: m_cdata->cnodes) {
+    setNodeCoordinates(cnode);
   }
 
-  qfile.close();
-
-  if (settings.getGraphLayout() == ngrt4n::NeatoLayout) {
+  if (graphLayout == ngrt4n::NeatoLayout) {
     m_cdata->min_x -= (max_text_w * 0.6);
     m_cdata->min_y -= (max_text_h * 0.6);
   }
@@ -351,6 +352,19 @@ int Parser::computeCoordinates(void)
   m_cdata->map_width += m_cdata->min_x;
   m_cdata->map_height += m_cdata->min_y;
 
+  if (isDynamicView) {
+    LayoutCache::PositionListT positions;
+    for (auto nodes: {&m_cdata->bpnodes, &m_cdata->cnodes}) {
+      for (const auto& node: *nodes) {
+        auto box = layout.box(node.id);
+        positions.insert(layoutKey(node), QPointF(box.x, box.y));
+      }
+    }
+    layoutCache.saveLatestPositions(m_viewFile, graphLayout, positions);
+  } else {
+    layoutCache.save(topologyHash, *m_cdata);
+  }
+
   return ngrt4n::RcSuccess;
 }
 
@@ -363,7 +377,7 @@ void Parser::insertITServiceNode(NodeT& node)
   QString srcid = ngrt4n::getSourceIdFromStr(dataPointInfo.first);
   if (srcid.isEmpty()) {
     srcid = ngrt4n::sourceId(0);
-    if (m_parsingMode == ParsingModeDashboard) {
+    if (m_parsingMode == ParsingModeDashboard || m_parsingMode == ParsingModeCollector) {
       node.child_nodes = ngrt4n::realCheckId(srcid, node.child_nodes);
     }
   }
@@ -29,7 +29,7 @@
 #include "utilsCore.hpp"
 #include "SettingFactory.hpp"
 #include "DbSession.hpp"
-#include <QDomNodeList>
+#include <QXmlStreamReader>
 
 
 class Parser : public QObject
@@ -39,6 +39,7 @@ class Parser : public QObject
     static const int ParsingModeEditor = 0;
     static const int ParsingModeDashboard = 1;
     static const int ParsingModeExternalService = 2;
+    static const int ParsingModeCollector = 3; // evaluation data only: no display fields, no layout
 
   public:
     Parser(CoreDataT* _cdata, int _parsingMode, DbSession* dbSession);
@@ -46,28 +47,22 @@ class Parser : public QObject
     int processRenderingData(void);
     std::pair<int, QString> parse(const QString& viewFile);
     int computeCoordinates(void);
-    QString dotContent(void) const {return m_dotContent;}
-    QString dotFile(void) const { return m_dotFile; }
+    void setViewFile(const QString& viewFile) {m_viewFile = viewFile;}
     QString lastErrorMsg(void) const {return m_lastErrorMsg;}
-    static QString escapeLabel4Graphviz(const QString& label);
-    static QString escapeId4Graphviz(const QString& id);
 
 
   private:
-    QString m_dotContent;
-    QString m_dotFile;
-    QString m_plainFile;
     CoreDataT* m_cdata;
+    QString m_viewFile;
     QString m_lastErrorMsg;
     int m_parsingMode;
     DbSession* m_dbSession;
 
 
     void fixupVisilityAndDependenciesGraph(void);
-    void saveCoordinatesFile(void);
     void insertITServiceNode(NodeT& node);
-    std::pair<int, QString> loadDynamicViewByGroup(QDomNodeList& inXmlDomNodes, CoreDataT& outCData);
-    void bindGraphDependencies(const NodeT& node);
+    void readServiceElement(QXmlStreamReader& xmlReader, NodeT& node);
+    std::pair<int, QString> loadDynamicViewByGroup(const QString& sourceId, const QString& monitoredGroup, CoreDataT& outCData);
 };
 
 #endif /* SNAVPARSESVCONFIG_H_ */
@@ -0,0 +1,186 @@
+/*
+ * PollingScheduler.cpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#include "PollingScheduler.hpp"
+#include <thread>
+
+
+PollingScheduler::PollingScheduler(qint32 defaultInterval)
+  : m_defaultInterval(qMax(1, defaultInterval)),
+    m_randomGenerator(std::random_device{}())
+{
+}
+
+
+void PollingScheduler::addView(const QString& viewName, const TimePointT& now)
+{
+  if (m_views.contains(viewName)) {
+    return;
+  }
+  ViewScheduleT schedule;
+  schedule.deadline = now + jitter(viewInterval(viewName));
+  m_views.insert(viewName, schedule);
+}
+
+
+void PollingScheduler::setViewSources(const QString& viewName, const QSet<QString>& sourceIds)
+{
+  auto view = m_views.find(viewName);
+  if (view != m_views.end()) {
+    view->sources = sourceIds;
+  }
+}
+
+
+void PollingScheduler::retainViews(const QSet<QString>& viewNames)
+{
+  auto view = m_views.begin();
+  while (view != m_views.end()) {
+    if (viewNames.contains(view.key())) {
+      ++view;
+    } else {
+      view = m_views.erase(view);
+    }
+  }
+}
+
+
+QStringList PollingScheduler::dueViews(const TimePointT& now) const
+{
+  QMultiMap<TimePointT::rep, QString> dueByDeadline;
+  for (auto view = m_views.cbegin(); view != m_views.cend(); ++view) {
+    if (view->deadline <= now) {
+      dueByDeadline.insert(view->deadline.time_since_epoch().count(), view.key());
+    }
+  }
+  return dueByDeadline.values();
+}
+
+
+void PollingScheduler::markCollected(const QString& viewName, const TimePointT& now)
+{
+  auto view = m_views.find(viewName);
+  if (view == m_views.end()) {
+    return;
+  }
+
+  const std::chrono::seconds period(viewInterval(viewName) * backoffFactor(viewName));
+  view->deadline += period;
+  if (view->deadline <= now) {
+    // the collection overran one or more periods: skip the missed slots instead of bursting
+    view->deadline += ((now - view->deadline) / period + 1) * period;
+  }
+}
+
+
+void PollingScheduler::reportSourceSuccess(const QString& sourceId)
+{
+  m_sourceFailures.remove(sourceId);
+}
+
+
+void PollingScheduler::reportSourceFailure(const QString& sourceId)
+{
+  auto failures = m_sourceFailures.find(sourceId);
+  if (failures == m_sourceFailures.end()) {
+    m_sourceFailures.insert(sourceId, 1);
+  } else {
+    ++(*failures);
+  }
+}
+
+
+qint32 PollingScheduler::viewInterval(const QString& viewName) const
+{
+  auto viewIntervalSetting = m_viewIntervals.find(viewName);
+  if (viewIntervalSetting != m_viewIntervals.end() && *viewIntervalSetting > 0) {
+    return *viewIntervalSetting;
+  }
+
+  qint32 interval = 0;
+  auto view = m_views.find(viewName);
+  if (view != m_views.end()) {
+    for (const auto& sid: view->sources) {
+      auto sourceIntervalSetting = m_sourceIntervals.find(sid);
+      if (sourceIntervalSetting != m_sourceIntervals.end() && *sourceIntervalSetting > 0) {
+        interval = (interval > 0) ? qMin(interval, *sourceIntervalSetting) : *sourceIntervalSetting;
+      }
+    }
+  }
+
+  return (interval > 0) ? interval : m_defaultInterval;
+}
+
+
+/**
+ * A view is only slowed down when all the sources it relies on are failing,
+ * the factor then doubles with each consecutive failure of its healthiest source.
+ */
+qint32 PollingScheduler::backoffFactor(const QString& viewName) const
+{
+  auto view = m_views.find(viewName);
+  if (view == m_views.end() || view->sources.isEmpty()) {
+    return 1;
+  }
+
+  qint32 factor = MAX_BACKOFF_FACTOR;
+  for (const auto& sid: view->sources) {
+    qint32 failures = qMin(m_sourceFailures.value(sid, 0), 8);
+    factor = qMin(factor, qMin(1 << failures, MAX_BACKOFF_FACTOR));
+  }
+
+  return factor;
+}
+
+
+PollingScheduler::TimePointT PollingScheduler::nextDeadline(const TimePointT& now) const
+{
+  if (m_views.isEmpty()) {
+    return now + std::chrono::seconds(m_defaultInterval);
+  }
+
+  TimePointT deadline = m_views.cbegin()->deadline;
+  for (const auto& view: m_views) {
+    deadline = qMin(deadline, view.deadline);
+  }
+
+  return deadline;
+}
+
+
+void PollingScheduler::waitForNextDeadline(void) const
+{
+  std::this_thread::sleep_until(nextDeadline(ClockT::now()));
+}
+
+
+std::chrono::milliseconds PollingScheduler::jitter(qint32 intervalSec) const
+{
+  auto maxJitterMs = static_cast<long long>(intervalSec * 1000 * START_JITTER_RATIO);
+  if (maxJitterMs <= 0) {
+    return std::chrono::milliseconds(0);
+  }
+  std::uniform_int_distribution<long long> distribution(0, maxJitterMs);
+  return std::chrono::milliseconds(distribution(m_randomGenerator));
+}
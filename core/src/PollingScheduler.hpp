@@ -0,0 +1,84 @@
+/*
+ * PollingScheduler.hpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#ifndef POLLINGSCHEDULER_HPP
+#define POLLINGSCHEDULER_HPP
+
+#include "Base.hpp"
+#include <chrono>
+#include <random>
+
+
+/**
+ * @brief Decides when each view has to be collected.
+ * Every view gets its own deadline, computed from its own interval (view setting first,
+ * then the shortest interval among its sources, then the global update interval).
+ * Deadlines are advanced by whole periods so that the collection time doesn't make them drift,
+ * first deadlines are jittered to spread the load, and views relying on failing sources
+ * are delayed with an exponential back-off. Source outcomes are to be reported once per
+ * collection cycle, however many views share the source.
+ */
+class PollingScheduler
+{
+public:
+  typedef std::chrono::steady_clock ClockT;
+  typedef ClockT::time_point TimePointT;
+
+  static constexpr double START_JITTER_RATIO = 0.1;
+  static constexpr qint32 MAX_BACKOFF_FACTOR = 16;
+
+  PollingScheduler(qint32 defaultInterval);
+  void setDefaultInterval(qint32 interval) { m_defaultInterval = qMax(1, interval); }
+  void setViewIntervals(const QMap<QString, qint32>& intervals) { m_viewIntervals = intervals; }
+  void setSourceIntervals(const QMap<QString, qint32>& intervals) { m_sourceIntervals = intervals; }
+  void addView(const QString& viewName, const TimePointT& now);
+  void setViewSources(const QString& viewName, const QSet<QString>& sourceIds);
+  void retainViews(const QSet<QString>& viewNames);
+  bool hasView(const QString& viewName) const { return m_views.contains(viewName); }
+  QStringList dueViews(const TimePointT& now) const;
+  void markCollected(const QString& viewName, const TimePointT& now);
+  void reportSourceSuccess(const QString& sourceId);
+  void reportSourceFailure(const QString& sourceId);
+  qint32 viewInterval(const QString& viewName) const;
+  qint32 backoffFactor(const QString& viewName) const;
+  TimePointT nextDeadline(const TimePointT& now) const;
+  void waitForNextDeadline(void) const;
+
+private:
+  struct ViewScheduleT {
+    TimePointT deadline;
+    QSet<QString> sources;
+  };
+
+  qint32 m_defaultInterval;
+  QMap<QString, qint32> m_viewIntervals;
+  QMap<QString, qint32> m_sourceIntervals;
+  QMap<QString, qint32> m_sourceFailures;
+  QMap<QString, ViewScheduleT> m_views;
+  mutable std::mt19937 m_randomGenerator;
+
+  std::chrono::milliseconds jitter(qint32 intervalSec) const;
+};
+
+#endif // POLLINGSCHEDULER_HPP
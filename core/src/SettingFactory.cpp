@@ -33,12 +33,16 @@ const QString SettingFactory::GLOBAL_LANGUAGE_KEY = "/General/language";
 const QString SettingFactory::GLOBAL_DB_STATE_KEY = "/General/DbState";
 const QString SettingFactory::GLOBAL_GRAPH_LAYOUT = "/General/graphLayout";
 const QString SettingFactory::GLOBAL_UPDATE_INTERVAL_KEY = "/Monitor/updateInterval";
+const QString SettingFactory::VIEW_UPDATE_INTERVALS_KEY = "/Monitor/viewUpdateIntervals";
+const QString SettingFactory::SOURCE_UPDATE_INTERVALS_KEY = "/Monitor/sourceUpdateIntervals";
+const QString SettingFactory::STATUS_RETENTION_DAYS_KEY = "/Monitor/statusRetentionDays";
 const QString SettingFactory::DB_TYPE = "/Database/dbType";
 const QString SettingFactory::DB_SERVER_ADDR = "/Database/dbServerAddr";
 const QString SettingFactory::DB_SERVER_PORT = "/Database/dbServerPort";
 const QString SettingFactory::DB_NAME = "/Database/dbName";
 const QString SettingFactory::DB_USER = "/Database/dbUser";
 const QString SettingFactory::DB_PASSWORD = "/Database/dbPassword";
+const QString SettingFactory::DB_CONNECTION_POOL_SIZE = "/Database/dbConnectionPoolSize";
 const QString SettingFactory::AUTH_MODE_KEY = "/Auth/authMode";
 const QString SettingFactory::AUTH_LDAP_SERVER_URI = "/Auth/ldapServerUri";
 const QString SettingFactory::AUTH_LDAP_BIND_USER_DN = "/Auth/ldapBindUserDn";
@@ -99,6 +103,40 @@ qint32 SettingFactory::updateInterval() const
   return (interval > 0)? interval : ngrt4n::DefaultUpdateInterval;
 }
 
+QMap<QString, qint32> SettingFactory::viewUpdateIntervals(void) const
+{
+  return parseIntervalList(entry(VIEW_UPDATE_INTERVALS_KEY));
+}
+
+QMap<QString, qint32> SettingFactory::sourceUpdateIntervals(void) const
+{
+  return parseIntervalList(entry(SOURCE_UPDATE_INTERVALS_KEY));
+}
+
+/* statusRetentionDays format: "raw=days;5m=days;1h=days;1d=days", data of the tiers not listed are kept forever */
+QMap<QString, qint32> SettingFactory::statusRetentionDays(void) const
+{
+  return parseIntervalList(entry(STATUS_RETENTION_DAYS_KEY));
+}
+
+/* intervalList format: "name1=seconds;name2=seconds" */
+QMap<QString, qint32> SettingFactory::parseIntervalList(const QString& intervalList)
+{
+  QMap<QString, qint32> intervals;
+  for (const auto& item: intervalList.split(";", QString::SkipEmptyParts)) {
+    int pos = item.lastIndexOf("=");
+    if (pos <= 0) {
+      continue;
+    }
+    bool ok = false;
+    qint32 interval = item.mid(pos + 1).trimmed().toInt(&ok);
+    if (ok && interval > 0) {
+      intervals.insert(item.left(pos).trimmed(), interval);
+    }
+  }
+  return intervals;
+}
+
 QString SettingFactory::language(void)
 {
   QString lang = SettingFactory().entry(GLOBAL_LANGUAGE_KEY);
@@ -129,6 +167,21 @@ QString SettingFactory::coreLogDir(void)
   return QString("%1/log").arg(coreAppDir());
 }
 
+QString SettingFactory::coreLayoutCacheDir(void)
+{
+  return QString("%1/cache/layouts").arg(coreDataDir());
+}
+
+QString SettingFactory::coreCompiledViewDir(void)
+{
+  return QString("%1/cache/views").arg(coreDataDir());
+}
+
+QString SettingFactory::coreStatusJournalDir(void)
+{
+  return QString("%1/journal").arg(coreDataDir());
+}
+
 QString SettingFactory::coreConfigPath(void)
 {
   return QString("%1/etc/realopinsight.conf").arg(coreAppDir());
@@ -38,12 +38,16 @@ public:
   static const QString GLOBAL_DB_STATE_KEY;
   static const QString GLOBAL_GRAPH_LAYOUT;
   static const QString GLOBAL_UPDATE_INTERVAL_KEY;
+  static const QString VIEW_UPDATE_INTERVALS_KEY;
+  static const QString SOURCE_UPDATE_INTERVALS_KEY;
+  static const QString STATUS_RETENTION_DAYS_KEY;
   static const QString DB_TYPE;
   static const QString DB_SERVER_ADDR;
   static const QString DB_SERVER_PORT;
   static const QString DB_NAME;
   static const QString DB_USER;
   static const QString DB_PASSWORD;
+  static const QString DB_CONNECTION_POOL_SIZE;
   static const QString AUTH_MODE_KEY;
   static const QString AUTH_LDAP_SERVER_URI;
   static const QString AUTH_LDAP_BIND_USER_DN;
@@ -69,6 +73,9 @@ public:
   static QString coreAppDir(void);
   static QString coreDataDir(void);
   static QString coreLogDir(void);
+  static QString coreLayoutCacheDir(void);
+  static QString coreCompiledViewDir(void);
+  static QString coreStatusJournalDir(void);
   static QString coreConfigPath(void);
   static std::string webConfigPath(void);
   void setKeyValue(const QString & key, const QString & value);
@@ -76,6 +83,10 @@ public:
     return QSettings::value(key).toString();
   }
   qint32 updateInterval() const;
+  QMap<QString, qint32> viewUpdateIntervals(void) const;
+  QMap<QString, qint32> sourceUpdateIntervals(void) const;
+  QMap<QString, qint32> statusRetentionDays(void) const;
+  static QMap<QString, qint32> parseIntervalList(const QString& intervalList);
   QString entry(const QString& key) const {
     return QSettings::value(key).toString();
   }
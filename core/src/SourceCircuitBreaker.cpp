@@ -0,0 +1,175 @@
+/*
+ * SourceCircuitBreaker.cpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#include "SourceCircuitBreaker.hpp"
+#include "utilsCore.hpp"
+#include "K8sHelper.hpp"
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QDebug>
+#include <ctime>
+#include <functional>
+
+
+namespace {
+  class ProbeTask : public QRunnable
+  {
+  public:
+    explicit ProbeTask(std::function<void(void)> run)
+      : m_run(run) { }
+
+    void run(void) override {
+      m_run();
+    }
+
+  private:
+    std::function<void(void)> m_run;
+  };
+}
+
+
+SourceCircuitBreaker& SourceCircuitBreaker::instance(void)
+{
+  static SourceCircuitBreaker breaker;
+  return breaker;
+}
+
+
+SourceCircuitBreaker::~SourceCircuitBreaker()
+{
+  m_probePool.waitForDone();
+}
+
+
+bool SourceCircuitBreaker::isOpen(const QString& sid)
+{
+  QMutexLocker locker(&m_mutex);
+  auto state = m_states.constFind(sid);
+  return state != m_states.cend() && state->failures >= FAILURE_THRESHOLD;
+}
+
+
+void SourceCircuitBreaker::recordSuccess(const QString& sid, const QHash<QString, CheckRefT>& checks)
+{
+  QMutexLocker locker(&m_mutex);
+  auto& state = m_states[sid];
+  state.failures = 0;
+  state.openedAt = 0;
+  state.lastSuccessAt = std::time(nullptr);
+  for (auto check = checks.cbegin(); check != checks.cend(); ++check) {
+    state.lastGoodChecks.insert(check.key().toLower(), check.value());
+  }
+}
+
+
+/**
+ * Cycles are increasing, a failure of a cycle already counted, or of an older one finishing late, is ignored.
+ */
+void SourceCircuitBreaker::recordFailure(const QString& sid, quint64 cycle)
+{
+  QMutexLocker locker(&m_mutex);
+  auto& state = m_states[sid];
+  if (cycle != 0) {
+    if (cycle <= state.lastFailedCycle) {
+      return;
+    }
+    state.lastFailedCycle = cycle;
+  }
+  ++state.failures;
+  if (state.failures == FAILURE_THRESHOLD) {
+    state.openedAt = std::time(nullptr);
+    qDebug() << QObject::tr("%1: short-circuited after %2 consecutive failures").arg(sid).arg(state.failures);
+  }
+}
+
+
+bool SourceCircuitBreaker::lastGoodCheck(const QString& sid, const QString& dataPointId, CheckRefT& check, qint64& staleSince)
+{
+  QMutexLocker locker(&m_mutex);
+  auto state = m_states.constFind(sid);
+  if (state == m_states.cend()) {
+    return false;
+  }
+
+  auto lastCheck = state->lastGoodChecks.constFind(dataPointId.toLower());
+  if (lastCheck == state->lastGoodChecks.cend()) {
+    return false;
+  }
+
+  check = *lastCheck;
+  staleSince = state->lastSuccessAt;
+  return true;
+}
+
+
+/**
+ * Starts a probe only when the cool-down period of an open source is over and no other probe
+ * is already running for it, so that callers never wait on an unreachable source.
+ */
+void SourceCircuitBreaker::probeInBackground(const SourceT& src, const QString& filter)
+{
+  {
+    QMutexLocker locker(&m_mutex);
+    auto state = m_states.find(src.id);
+    if (state == m_states.end()
+        || state->failures < FAILURE_THRESHOLD
+        || state->probing
+        || std::time(nullptr) - state->openedAt < COOL_DOWN_PERIOD) {
+      return;
+    }
+    state->probing = true;
+  }
+
+  m_probePool.start(new ProbeTask([this, src, filter]() {
+    handleProbeResult(src.id, probe(src, filter));
+  }));
+}
+
+
+void SourceCircuitBreaker::handleProbeResult(const QString& sid, bool succeeded)
+{
+  QMutexLocker locker(&m_mutex);
+  auto& state = m_states[sid];
+  state.probing = false;
+  if (succeeded) {
+    // let the next update cycle query the source again and refresh the last good checks
+    state.failures = 0;
+    state.openedAt = 0;
+    qDebug() << QObject::tr("%1: probe succeeded, source restored").arg(sid);
+  } else {
+    state.openedAt = std::time(nullptr);
+  }
+}
+
+
+bool SourceCircuitBreaker::probe(const SourceT& src, const QString& filter)
+{
+  if (src.mon_type == MonitorT::Kubernetes) {
+    CoreDataT cdata;
+    return K8sHelper(src.mon_url, src.verify_ssl_peer, src.auth).loadNamespaceView(filter, cdata).second == ngrt4n::RcSuccess;
+  }
+
+  ChecksT checks;
+  return ngrt4n::loadDataItems(src, filter, checks).first == ngrt4n::RcSuccess;
+}
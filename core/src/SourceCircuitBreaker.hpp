@@ -0,0 +1,78 @@
+/*
+ * SourceCircuitBreaker.hpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#ifndef SOURCECIRCUITBREAKER_HPP
+#define SOURCECIRCUITBREAKER_HPP
+
+#include "Base.hpp"
+#include <QMutex>
+#include <QHash>
+#include <QThreadPool>
+
+
+/**
+ * @brief Process-wide circuit breaker guarding the monitoring data sources.
+ * After FAILURE_THRESHOLD consecutive failures a source is short-circuited: dashboards stop
+ * querying it and serve the last known good checks instead, while a single probe is run
+ * in the background every COOL_DOWN_PERIOD seconds until the source answers again.
+ * Failures are counted once per polling cycle, so that the views sharing a source in the same
+ * cycle only count for one failure, whether their fetches overlap or not.
+ */
+class SourceCircuitBreaker
+{
+public:
+  static constexpr int FAILURE_THRESHOLD = 3;
+  static constexpr qint64 COOL_DOWN_PERIOD = 60;
+
+  static SourceCircuitBreaker& instance(void);
+
+  bool isOpen(const QString& sid);
+  void recordSuccess(const QString& sid, const QHash<QString, CheckRefT>& checks);
+  void recordFailure(const QString& sid, quint64 cycle); // cycle 0 is not part of a polling cycle, always counted
+  bool lastGoodCheck(const QString& sid, const QString& dataPointId, CheckRefT& check, qint64& staleSince);
+  void probeInBackground(const SourceT& src, const QString& filter);
+
+private:
+  struct SourceStateT {
+    int failures = 0;
+    qint64 openedAt = 0;
+    qint64 lastSuccessAt = 0;
+    bool probing = false;
+    quint64 lastFailedCycle = 0;
+    QHash<QString, CheckRefT> lastGoodChecks;
+  };
+
+  QMutex m_mutex;
+  QHash<QString, SourceStateT> m_states;
+  QThreadPool m_probePool; // last member, so that running probes are waited for before the states are destroyed
+
+  SourceCircuitBreaker(void) = default;
+  ~SourceCircuitBreaker();
+  SourceCircuitBreaker(const SourceCircuitBreaker&) = delete;
+  SourceCircuitBreaker& operator=(const SourceCircuitBreaker&) = delete;
+  void handleProbeResult(const QString& sid, bool succeeded);
+  static bool probe(const SourceT& src, const QString& filter);
+};
+
+#endif // SOURCECIRCUITBREAKER_HPP
@@ -0,0 +1,311 @@
+/*
+ * StatusJournal.cpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#include "StatusJournal.hpp"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QDebug>
+#include <algorithm>
+
+
+namespace {
+  const qint64 FILE_HEADER_SIZE = 8;   // magic, format version
+  const qint64 RECORD_HEADER_SIZE = 20; // record size, first and last timestamps
+
+  void writeVarint(QByteArray& out, quint64 value)
+  {
+    while (value >= 0x80) {
+      out.append(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+  }
+
+  bool readVarint(const uchar* data, qint64 size, qint64& pos, quint64& value)
+  {
+    value = 0;
+    for (int shift = 0; pos < size && shift < 64; shift += 7) {
+      const uchar byte = data[pos++];
+      value |= static_cast<quint64>(byte & 0x7f) << shift;
+      if (! (byte & 0x80)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  quint32 readUInt32(const uchar* data)
+  {
+    return (static_cast<quint32>(data[0]) << 24) | (static_cast<quint32>(data[1]) << 16)
+        | (static_cast<quint32>(data[2]) << 8) | static_cast<quint32>(data[3]);
+  }
+
+  qint64 readInt64(const uchar* data)
+  {
+    return static_cast<qint64>((static_cast<quint64>(readUInt32(data)) << 32) | readUInt32(data + 4));
+  }
+} // namespace
+
+
+StatusJournal::StatusJournal(const QString& journalDir)
+  : m_journalDir(journalDir)
+{
+}
+
+
+bool StatusJournal::append(const QString& viewName, const StatusTransitionListT& transitions)
+{
+  if (transitions.isEmpty()) {
+    return true;
+  }
+
+  auto viewJournal = this->viewJournal(viewName);
+  if (! viewJournal) {
+    return false;
+  }
+
+  StatusTransitionListT sortedTransitions = transitions;
+  std::stable_sort(sortedTransitions.begin(), sortedTransitions.end(), [](const StatusTransitionT& t1, const StatusTransitionT& t2) {
+    return t1.timestamp < t2.timestamp;
+  });
+
+  auto nodeIndexes = viewJournal->nodeIndexes;
+  auto lastSeverities = viewJournal->lastSeverities;
+  QByteArray newNodeIds;
+  quint64 newNodeCount = 0;
+  QByteArray entries;
+  const qint64 firstTimestamp = sortedTransitions.first().timestamp;
+  qint64 previousTimestamp = firstTimestamp;
+  for (const auto& transition: sortedTransitions) {
+    auto nodeIndex = nodeIndexes.constFind(transition.nodeId);
+    if (nodeIndex == nodeIndexes.cend()) {
+      nodeIndex = nodeIndexes.insert(transition.nodeId, static_cast<quint32>(nodeIndexes.size()));
+      auto nodeIdData = transition.nodeId.toUtf8();
+      writeVarint(newNodeIds, static_cast<quint64>(nodeIdData.size()));
+      newNodeIds.append(nodeIdData);
+      ++newNodeCount;
+    }
+    writeVarint(entries, *nodeIndex);
+    writeVarint(entries, static_cast<quint64>(transition.timestamp - previousTimestamp));
+    entries.append(static_cast<char>(transition.oldSeverity));
+    entries.append(static_cast<char>(transition.newSeverity));
+    while (lastSeverities.size() <= static_cast<int>(*nodeIndex)) {
+      lastSeverities.push_back(-1);
+    }
+    lastSeverities[static_cast<int>(*nodeIndex)] = transition.newSeverity;
+    previousTimestamp = transition.timestamp;
+  }
+
+  QByteArray payload;
+  writeVarint(payload, newNodeCount);
+  payload.append(newNodeIds);
+  writeVarint(payload, static_cast<quint64>(sortedTransitions.size()));
+  payload.append(entries);
+
+  QByteArray record;
+  QDataStream out(&record, QIODevice::WriteOnly);
+  if (viewJournal->validSize == 0) {
+    out << MAGIC << FORMAT_VERSION;
+  }
+  out << static_cast<quint32>(RECORD_HEADER_SIZE - 4 + payload.size()) << firstTimestamp << previousTimestamp;
+  out.writeRawData(payload.constData(), payload.size());
+
+  if (! QDir().mkpath(m_journalDir)) {
+    qDebug() << QObject::tr("Cannot create status journal directory: %1").arg(m_journalDir);
+    return false;
+  }
+
+  QFile file(journalPath(viewName));
+  if (! file.open(QIODevice::ReadWrite)) {
+    qDebug() << QObject::tr("Cannot open status journal: %1").arg(file.fileName());
+    return false;
+  }
+  // drop any incomplete record left by an interrupted append
+  if (file.size() != viewJournal->validSize && ! file.resize(viewJournal->validSize)) {
+    qDebug() << QObject::tr("Cannot truncate status journal: %1").arg(file.fileName());
+    return false;
+  }
+  if (! file.seek(viewJournal->validSize)
+      || file.write(record) != record.size()
+      || ! file.flush()) {
+    qDebug() << QObject::tr("Cannot write status journal: %1").arg(file.fileName());
+    return false;
+  }
+
+  viewJournal->nodeIndexes = nodeIndexes;
+  viewJournal->lastSeverities = lastSeverities;
+  viewJournal->validSize += record.size();
+
+  return true;
+}
+
+
+QHash<QString, qint32> StatusJournal::lastSeverities(const QString& viewName)
+{
+  QHash<QString, qint32> severities;
+  auto journal = viewJournal(viewName);
+  if (! journal) {
+    return severities;
+  }
+  for (auto nodeIndex = journal->nodeIndexes.cbegin(); nodeIndex != journal->nodeIndexes.cend(); ++nodeIndex) {
+    if (static_cast<int>(nodeIndex.value()) < journal->lastSeverities.size() && journal->lastSeverities[nodeIndex.value()] >= 0) {
+      severities.insert(nodeIndex.key(), journal->lastSeverities[nodeIndex.value()]);
+    }
+  }
+  return severities;
+}
+
+
+QString StatusJournal::journalPath(const QString& viewName) const
+{
+  auto viewNameHash = QCryptographicHash::hash(viewName.toUtf8(), QCryptographicHash::Sha1).toHex();
+  return QString("%1/%2.journal").arg(m_journalDir, QString::fromLatin1(viewNameHash));
+}
+
+
+StatusJournal::ViewJournalT* StatusJournal::viewJournal(const QString& viewName)
+{
+  auto viewJournal = m_viewJournals.find(viewName);
+  if (viewJournal == m_viewJournals.end()) {
+    ViewJournalT loadedJournal;
+    if (! loadViewJournal(viewName, loadedJournal)) {
+      return nullptr;
+    }
+    viewJournal = m_viewJournals.insert(viewName, loadedJournal);
+  }
+  return &(*viewJournal);
+}
+
+
+bool StatusJournal::loadViewJournal(const QString& viewName, ViewJournalT& viewJournal) const
+{
+  auto handleRecord = [&viewJournal](qint64, qint64, const QStringList& nodeIds, const uchar* entries, qint64 entriesSize) {
+    for (int index = viewJournal.nodeIndexes.size(); index < nodeIds.size(); ++index) {
+      viewJournal.nodeIndexes.insert(nodeIds[index], static_cast<quint32>(index));
+    }
+    while (viewJournal.lastSeverities.size() < nodeIds.size()) {
+      viewJournal.lastSeverities.push_back(-1);
+    }
+
+    // entries are in timestamp order, the last one of a node holds its current severity
+    qint64 pos = 0;
+    quint64 entryCount;
+    if (! readVarint(entries, entriesSize, pos, entryCount)) {
+      return;
+    }
+    for (quint64 entry = 0; entry < entryCount; ++entry) {
+      quint64 index;
+      quint64 delta;
+      if (! readVarint(entries, entriesSize, pos, index)
+          || ! readVarint(entries, entriesSize, pos, delta)
+          || pos + 2 > entriesSize) {
+        return;
+      }
+      pos += 1; // old severity
+      const qint8 newSeverity = static_cast<qint8>(entries[pos++]);
+      if (index < static_cast<quint64>(nodeIds.size())) {
+        viewJournal.lastSeverities[static_cast<int>(index)] = newSeverity;
+      }
+    }
+  };
+  return readRecords(viewName, viewJournal.validSize, handleRecord);
+}
+
+
+bool StatusJournal::readRecords(const QString& viewName, qint64& validSize, const RecordHandlerT& handleRecord) const
+{
+  validSize = 0;
+  QFile file(journalPath(viewName));
+  // a file without a complete header was left by an interrupted first append, it is read as empty and rewritten
+  if (! file.exists() || file.size() < FILE_HEADER_SIZE) {
+    return true;
+  }
+  if (! file.open(QIODevice::ReadOnly)) {
+    qDebug() << QObject::tr("Cannot read status journal: %1").arg(file.fileName());
+    return false;
+  }
+
+  const qint64 size = file.size();
+  uchar* data = file.map(0, size);
+  if (! data) {
+    return false;
+  }
+  if (readUInt32(data) != MAGIC) {
+    // not written by this journal, kept aside for inspection rather than overwritten
+    file.unmap(data);
+    file.close();
+    const QString asidePath = QString("%1.invalid-%2").arg(file.fileName()).arg(QDateTime::currentSecsSinceEpoch());
+    if (! QFile::rename(file.fileName(), asidePath)) {
+      qDebug() << QObject::tr("Status journal with an unknown header, cannot move it aside: %1").arg(file.fileName());
+      return false;
+    }
+    qDebug() << QObject::tr("Status journal with an unknown header moved aside to %1, starting a new one").arg(asidePath);
+    return true;
+  }
+  if (static_cast<qint32>(readUInt32(data + 4)) != FORMAT_VERSION) {
+    qDebug() << QObject::tr("Unsupported status journal: %1").arg(file.fileName());
+    file.unmap(data);
+    return false;
+  }
+
+  QStringList nodeIds;
+  qint64 pos = FILE_HEADER_SIZE;
+  validSize = pos;
+  while (pos + RECORD_HEADER_SIZE <= size) {
+    const qint64 recordEnd = pos + 4 + readUInt32(data + pos);
+    if (recordEnd > size) {
+      break;
+    }
+    const qint64 firstTimestamp = readInt64(data + pos + 4);
+    const qint64 lastTimestamp = readInt64(data + pos + 12);
+    pos += RECORD_HEADER_SIZE;
+
+    quint64 newNodeCount;
+    if (! readVarint(data, recordEnd, pos, newNodeCount)) {
+      break;
+    }
+    bool validRecord = true;
+    for (quint64 node = 0; node < newNodeCount && validRecord; ++node) {
+      quint64 nodeIdSize;
+      validRecord = readVarint(data, recordEnd, pos, nodeIdSize) && pos + static_cast<qint64>(nodeIdSize) <= recordEnd;
+      if (validRecord) {
+        nodeIds.push_back(QString::fromUtf8(reinterpret_cast<const char*>(data + pos), static_cast<int>(nodeIdSize)));
+        pos += static_cast<qint64>(nodeIdSize);
+      }
+    }
+    if (! validRecord) {
+      break;
+    }
+
+    handleRecord(firstTimestamp, lastTimestamp, nodeIds, data + pos, recordEnd - pos);
+    pos = recordEnd;
+    validSize = pos;
+  }
+
+  file.unmap(data);
+  return true;
+}
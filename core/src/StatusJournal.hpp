@@ -0,0 +1,81 @@
+/*
+ * StatusJournal.hpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#ifndef STATUSJOURNAL_HPP
+#define STATUSJOURNAL_HPP
+
+#include "Base.hpp"
+#include <functional>
+
+
+struct StatusTransitionT {
+  QString nodeId;
+  qint64 timestamp;
+  qint8 oldSeverity; // -1 when the node is observed for the first time
+  qint8 newSeverity;
+};
+typedef QVector<StatusTransitionT> StatusTransitionListT;
+
+
+/**
+ * @brief Append-only journal of the severity changes of the nodes of each view.
+ * Each view has its own file, so that reading a node history never touches the other views. Transitions are
+ * appended in batches (one record per view and collection cycle); a record holds its time range, the node ids
+ * seen for the first time in the view (later referenced by their index), then the transitions with timestamps
+ * delta-encoded from the start of the record. Integers are written as variable-length quantities.
+ * A record left incomplete by a crash is ignored when reading and overwritten by the next append; a file with
+ * an unknown header is renamed aside and a new journal started.
+ * The last severity of each node is kept, so that a restarted collector resumes from it instead of journaling
+ * every node again as seen for the first time.
+ * Appends are not thread-safe, a single writer is expected per journal directory.
+ */
+class StatusJournal
+{
+public:
+  static const quint32 MAGIC = 0x524f494a; // "ROIJ"
+  static const qint32 FORMAT_VERSION = 1;
+
+  StatusJournal(const QString& journalDir);
+  bool append(const QString& viewName, const StatusTransitionListT& transitions);
+  QHash<QString, qint32> lastSeverities(const QString& viewName); // by node id, empty if the journal cannot be read
+
+private:
+  struct ViewJournalT {
+    QHash<QString, quint32> nodeIndexes;
+    QVector<qint8> lastSeverities; // by node index
+    qint64 validSize = 0;
+  };
+  typedef std::function<void(qint64 firstTimestamp, qint64 lastTimestamp, const QStringList& nodeIds,
+                             const uchar* entries, qint64 entriesSize)> RecordHandlerT;
+
+  QString m_journalDir;
+  QHash<QString, ViewJournalT> m_viewJournals;
+
+  QString journalPath(const QString& viewName) const;
+  ViewJournalT* viewJournal(const QString& viewName);
+  bool loadViewJournal(const QString& viewName, ViewJournalT& viewJournal) const;
+  bool readRecords(const QString& viewName, qint64& validSize, const RecordHandlerT& handleRecord) const;
+};
+
+#endif // STATUSJOURNAL_HPP
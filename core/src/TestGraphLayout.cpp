@@ -0,0 +1,110 @@
+/*
+ * TestGraphLayout.cpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#include "TestGraphLayout.hpp"
+#include "GraphLayout.hpp"
+#include <QtTest/QtTest>
+#include <cmath>
+
+
+void TestGraphLayout::test_layeredRanks(void)
+{
+  GraphLayout layout(ngrt4n::DotLayout);
+  layout.addNode("root", "root");
+  layout.addNode("a", "a");
+  layout.addNode("b", "b");
+  layout.addNode("c", "c");
+  layout.addEdge("root", "a");
+  layout.addEdge("root", "b");
+  layout.addEdge("a", "c");
+  layout.addEdge("root", "c"); // c stays below its deepest parent
+  layout.run();
+
+  QVERIFY(layout.box("root").y < layout.box("a").y);
+  QCOMPARE(layout.box("a").y, layout.box("b").y);
+  QVERIFY(layout.box("a").y < layout.box("c").y);
+  QCOMPARE(layout.box("c").y - layout.box("a").y, layout.box("a").y - layout.box("root").y);
+}
+
+
+void TestGraphLayout::test_siblingsDoNotOverlap(void)
+{
+  GraphLayout layout(ngrt4n::DotLayout);
+  layout.addNode("root", "root");
+  for (int index = 0; index < 5; ++index) {
+    auto child = QString("a rather long child label %1").arg(index);
+    layout.addNode(child, child);
+    layout.addEdge("root", child);
+  }
+  layout.run();
+
+  for (int lhs = 0; lhs < 5; ++lhs) {
+    for (int rhs = lhs + 1; rhs < 5; ++rhs) {
+      auto lhsBox = layout.box(QString("a rather long child label %1").arg(lhs));
+      auto rhsBox = layout.box(QString("a rather long child label %1").arg(rhs));
+      QVERIFY(std::abs(lhsBox.x - rhsBox.x) >= (lhsBox.width + rhsBox.width) / 2);
+    }
+  }
+  QVERIFY(layout.width() > 0);
+  QVERIFY(layout.height() > 0);
+}
+
+
+void TestGraphLayout::test_cycleIsBroken(void)
+{
+  GraphLayout layout(ngrt4n::DotLayout);
+  layout.addNode("a", "a");
+  layout.addNode("b", "b");
+  layout.addNode("c", "c");
+  layout.addEdge("a", "b");
+  layout.addEdge("b", "c");
+  layout.addEdge("c", "a");
+  layout.run();
+
+  // the cycle is released at its first node, the others follow it rank after rank
+  QVERIFY(layout.box("a").y < layout.box("b").y);
+  QVERIFY(layout.box("b").y < layout.box("c").y);
+}
+
+
+void TestGraphLayout::test_pinnedNodesKeepTheirPlace(void)
+{
+  GraphLayout layout(ngrt4n::DotLayout);
+  layout.addNode("p1", "p1");
+  layout.addNode("p2", "p2");
+  layout.addNode("child", "child");
+  layout.addEdge("p1", "child");
+  layout.pinNode("p1", 0, 0);
+  layout.pinNode("p2", 5, 0);
+  layout.run();
+
+  auto p1 = layout.box("p1");
+  auto p2 = layout.box("p2");
+  auto child = layout.box("child");
+  QCOMPARE(p2.x - p1.x, 5.0);
+  QCOMPARE(p2.y, p1.y);
+  QVERIFY(child.y > p1.y);
+  QVERIFY(std::abs(child.x - p1.x) >= (child.width + p1.width) / 2
+          || std::abs(child.y - p1.y) >= (child.height + p1.height) / 2);
+}
@@ -1,8 +1,8 @@
 /*
- * WebBiSlaChart.hpp
+ * TestGraphLayout.hpp
 # ------------------------------------------------------------------------ #
-# Copyright (c) 2010-2015 Rodrigue Chakode (rodrigue.chakode@ngrt4n.com)   #
-# Creation: 26-07-2015                                                     #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
 #                                                                          #
 # This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
 # by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
@@ -22,39 +22,20 @@
 #--------------------------------------------------------------------------#
  */
 
-#ifndef WEBBISLACHART_HPP
-#define WEBBISLACHART_HPP
+#ifndef TESTGRAPHLAYOUT_HPP
+#define TESTGRAPHLAYOUT_HPP
 
-#include "dbo/src/DbObjects.hpp"
+#include <QObject>
 
-class WebPlatformStatusAnalyticsData
+class TestGraphLayout : public QObject
 {
-public:
-  WebPlatformStatusAnalyticsData(const ListofPlatformStatusT& data);
+  Q_OBJECT
 
-  double normalDuration(void) const {return m_normalDuration;}
-  double minorDuration(void) const {return m_minorDuration;}
-  double majorDuration(void) const {return m_majorDuration;}
-  double criticalDuration(void) const {return m_criticalDuration;}
-  double unknownDuration(void) const {return m_unknownDuration;}
-  double totalDuration(void) const {return m_totalDuration;}
-
-
-private:
-  struct TimeStatusT {
-    long timestamp;
-    int status;
-  };
-  typedef QList<TimeStatusT> TimeStatusesT;
-  TimeStatusesT m_plottingData;
-  long m_normalDuration;
-  long m_minorDuration;
-  long m_majorDuration;
-  long m_criticalDuration;
-  long m_unknownDuration;
-  long m_totalDuration;
-
-  void processData(const ListofPlatformStatusT& data);
+private Q_SLOTS:
+  void test_layeredRanks(void);
+  void test_siblingsDoNotOverlap(void);
+  void test_cycleIsBroken(void);
+  void test_pinnedNodesKeepTheirPlace(void);
 };
 
-#endif // WEBBISLACHART_HPP
+#endif // TESTGRAPHLAYOUT_HPP
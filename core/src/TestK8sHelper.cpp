@@ -122,5 +122,3 @@ void TestK8sHelper::test_httpDataRetrieving(void)
         ngrt4n::saveViewDataToPath(cdata, "/tmp/roi_"+ns+".xml");
     }
 }
-
-QTEST_MAIN(TestK8sHelper)
@@ -0,0 +1,174 @@
+/*
+ * TestStatusJournal.cpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#include "TestStatusJournal.hpp"
+#include "StatusJournal.hpp"
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+
+namespace {
+  const QString VIEW_NAME = "view1";
+
+  QString journalFile(const QTemporaryDir& dir)
+  {
+    auto files = QDir(dir.path()).entryList(QStringList() << "*.journal", QDir::Files);
+    return files.isEmpty() ? QString() : dir.filePath(files.first());
+  }
+}
+
+
+void TestStatusJournal::test_lastSeveritiesAfterReopen(void)
+{
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  {
+    StatusJournal journal(dir.path());
+    // transitions are sorted by timestamp within a record
+    QVERIFY(journal.append(VIEW_NAME, StatusTransitionListT{{"host1/cpu", 1010, ngrt4n::Normal, ngrt4n::Major},
+                                                            {"host1", 1000, -1, ngrt4n::Normal},
+                                                            {"host1/cpu", 1005, -1, ngrt4n::Normal}}));
+    QVERIFY(journal.append(VIEW_NAME, StatusTransitionListT{{"host1/cpu", 2000, ngrt4n::Major, ngrt4n::Critical}}));
+    auto severities = journal.lastSeverities(VIEW_NAME);
+    QCOMPARE(severities.size(), 2);
+    QCOMPARE(severities.value("host1/cpu"), qint32(ngrt4n::Critical));
+  }
+
+  // a restarted collector resumes from the severities read back from the file
+  StatusJournal journal(dir.path());
+  auto severities = journal.lastSeverities(VIEW_NAME);
+  QCOMPARE(severities.size(), 2);
+  QCOMPARE(severities.value("host1"), qint32(ngrt4n::Normal));
+  QCOMPARE(severities.value("host1/cpu"), qint32(ngrt4n::Critical));
+
+  QVERIFY(journal.lastSeverities("unknown view").isEmpty());
+}
+
+
+void TestStatusJournal::test_reopenAfterTruncatedTail(void)
+{
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  {
+    StatusJournal journal(dir.path());
+    QVERIFY(journal.append(VIEW_NAME, StatusTransitionListT{{"host1", 1000, -1, ngrt4n::Normal}}));
+    QVERIFY(journal.append(VIEW_NAME, StatusTransitionListT{{"host1", 2000, ngrt4n::Normal, ngrt4n::Critical}}));
+  }
+
+  // simulates an append interrupted in the middle of the last record
+  QFile file(journalFile(dir));
+  QVERIFY(file.open(QIODevice::ReadWrite));
+  QVERIFY(file.resize(file.size() - 3));
+  file.close();
+
+  {
+    StatusJournal journal(dir.path());
+    QCOMPARE(journal.lastSeverities(VIEW_NAME).value("host1"), qint32(ngrt4n::Normal));
+    QVERIFY(journal.append(VIEW_NAME, StatusTransitionListT{{"host1", 2500, ngrt4n::Normal, ngrt4n::Minor}}));
+  }
+
+  StatusJournal journal(dir.path());
+  QCOMPARE(journal.lastSeverities(VIEW_NAME).value("host1"), qint32(ngrt4n::Minor));
+}
+
+
+void TestStatusJournal::test_shortFileIsRewritten(void)
+{
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  {
+    StatusJournal journal(dir.path());
+    QVERIFY(journal.append(VIEW_NAME, StatusTransitionListT{{"host1", 1000, -1, ngrt4n::Normal}}));
+  }
+
+  // simulates a first append interrupted within the file header
+  QFile file(journalFile(dir));
+  QVERIFY(file.open(QIODevice::ReadWrite));
+  QVERIFY(file.resize(3));
+  file.close();
+
+  {
+    StatusJournal journal(dir.path());
+    QVERIFY(journal.lastSeverities(VIEW_NAME).isEmpty());
+    QVERIFY(journal.append(VIEW_NAME, StatusTransitionListT{{"host1", 2000, ngrt4n::Normal, ngrt4n::Major}}));
+  }
+
+  StatusJournal journal(dir.path());
+  QCOMPARE(journal.lastSeverities(VIEW_NAME).value("host1"), qint32(ngrt4n::Major));
+}
+
+
+void TestStatusJournal::test_unknownHeaderIsMovedAside(void)
+{
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  {
+    StatusJournal journal(dir.path());
+    QVERIFY(journal.append(VIEW_NAME, StatusTransitionListT{{"host1", 1000, -1, ngrt4n::Normal}}));
+  }
+
+  QFile file(journalFile(dir));
+  QVERIFY(file.open(QIODevice::ReadWrite));
+  QVERIFY(file.write("JUNK") == 4);
+  file.close();
+  const auto corruptedSize = file.size();
+
+  StatusJournal journal(dir.path());
+  QVERIFY(journal.lastSeverities(VIEW_NAME).isEmpty());
+  auto asideFiles = QDir(dir.path()).entryList(QStringList() << "*.journal.invalid-*", QDir::Files);
+  QCOMPARE(asideFiles.size(), 1);
+  QCOMPARE(QFileInfo(dir.filePath(asideFiles.first())).size(), corruptedSize);
+
+  QVERIFY(journal.append(VIEW_NAME, StatusTransitionListT{{"host1", 2000, ngrt4n::Normal, ngrt4n::Major}}));
+  StatusJournal reopenedJournal(dir.path());
+  QCOMPARE(reopenedJournal.lastSeverities(VIEW_NAME).value("host1"), qint32(ngrt4n::Major));
+}
+
+
+void TestStatusJournal::test_nodeIdsAreInterned(void)
+{
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  const QString nodeId = "a rather long node identifier/cpu";
+  {
+    StatusJournal journal(dir.path());
+    QVERIFY(journal.append(VIEW_NAME, StatusTransitionListT{{nodeId, 1000, -1, ngrt4n::Normal}}));
+    QVERIFY(journal.append(VIEW_NAME, StatusTransitionListT{{nodeId, 2000, ngrt4n::Normal, ngrt4n::Major},
+                                                            {"host2", 2000, -1, ngrt4n::Normal}}));
+  }
+  // the node indexes are reloaded from the file by a new journal
+  {
+    StatusJournal journal(dir.path());
+    QVERIFY(journal.append(VIEW_NAME, StatusTransitionListT{{nodeId, 3000, ngrt4n::Major, ngrt4n::Minor}}));
+  }
+
+  QFile file(journalFile(dir));
+  QVERIFY(file.open(QIODevice::ReadOnly));
+  QCOMPARE(file.readAll().count(nodeId.toUtf8()), 1);
+
+  StatusJournal journal(dir.path());
+  auto severities = journal.lastSeverities(VIEW_NAME);
+  QCOMPARE(severities.value(nodeId), qint32(ngrt4n::Minor));
+  QCOMPARE(severities.value("host2"), qint32(ngrt4n::Normal));
+}
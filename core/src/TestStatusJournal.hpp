@@ -0,0 +1,42 @@
+/*
+ * TestStatusJournal.hpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#ifndef TESTSTATUSJOURNAL_HPP
+#define TESTSTATUSJOURNAL_HPP
+
+#include <QObject>
+
+class TestStatusJournal : public QObject
+{
+  Q_OBJECT
+
+private Q_SLOTS:
+  void test_lastSeveritiesAfterReopen(void);
+  void test_reopenAfterTruncatedTail(void);
+  void test_shortFileIsRewritten(void);
+  void test_unknownHeaderIsMovedAside(void);
+  void test_nodeIdsAreInterned(void);
+};
+
+#endif // TESTSTATUSJOURNAL_HPP
@@ -0,0 +1,75 @@
+/*
+ * ViewDependencyGraph.cpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#include "ViewDependencyGraph.hpp"
+#include <QObject>
+#include <QDebug>
+
+
+void ViewDependencyGraph::addView(const QString& viewName, const QSet<QString>& referencedViews)
+{
+  m_references[viewName] = referencedViews;
+}
+
+
+std::vector<QStringList> ViewDependencyGraph::evaluationWaves(void) const
+{
+  QHash<QString, QSet<QString>> pendingReferences;
+  for (auto view = m_references.cbegin(); view != m_references.cend(); ++view) {
+    auto& pending = pendingReferences[view.key()];
+    for (const auto& referencedView: view.value()) {
+      if (referencedView != view.key() && m_references.contains(referencedView)) {
+        pending.insert(referencedView);
+      }
+    }
+  }
+
+  std::vector<QStringList> waves;
+  while (! pendingReferences.isEmpty()) {
+    QStringList wave;
+    for (auto view = pendingReferences.cbegin(); view != pendingReferences.cend(); ++view) {
+      if (view.value().isEmpty()) {
+        wave.push_back(view.key());
+      }
+    }
+
+    if (wave.isEmpty()) {
+      wave = pendingReferences.keys();
+      qDebug() << QObject::tr("circular references between views: %1").arg(wave.join(", "));
+    }
+
+    wave.sort();
+    for (const auto& viewName: wave) {
+      pendingReferences.remove(viewName);
+    }
+    for (auto& pending: pendingReferences) {
+      for (const auto& viewName: wave) {
+        pending.remove(viewName);
+      }
+    }
+    waves.push_back(wave);
+  }
+
+  return waves;
+}
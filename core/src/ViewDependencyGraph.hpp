@@ -0,0 +1,61 @@
+/*
+ * ViewDependencyGraph.hpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#ifndef VIEWDEPENDENCYGRAPH_HPP
+#define VIEWDEPENDENCYGRAPH_HPP
+
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <vector>
+
+
+/**
+ * @brief Root status of a view evaluated in the process, read by the external service nodes referencing it.
+ */
+struct ViewStatusT {
+  int sev;
+  qint64 timestamp;
+};
+typedef QHash<QString, ViewStatusT> ViewStatusMapT;
+
+
+/**
+ * @brief Dependencies between views through their external service nodes.
+ * Views are split into evaluation waves so that a view is only evaluated once all the views
+ * it references have been, its external nodes can then read their status from memory.
+ * References to views that are not in the graph are ignored, views involved in a cycle are
+ * evaluated together in the last wave.
+ */
+class ViewDependencyGraph
+{
+public:
+  void addView(const QString& viewName, const QSet<QString>& referencedViews);
+  std::vector<QStringList> evaluationWaves(void) const;
+
+private:
+  QHash<QString, QSet<QString>> m_references;
+};
+
+#endif // VIEWDEPENDENCYGRAPH_HPP
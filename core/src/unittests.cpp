@@ -1,4 +1,11 @@
 #include "StatusAggregator.hpp"
+#include "PollingScheduler.hpp"
+#include "CheckRegistry.hpp"
+#include "ViewDependencyGraph.hpp"
+#include "SourceCircuitBreaker.hpp"
+#include "TestK8sHelper.hpp"
+#include "TestGraphLayout.hpp"
+#include "TestStatusJournal.hpp"
 #include <QCoreApplication>
 #include <QtTest/QTest>
 
@@ -151,6 +158,319 @@ void TestStatusAggregation::testWorst(void)
   QCOMPARE(m_StatusAggregator->aggregate(CalcRules::Worst, thresholdsLimits), static_cast<int>(ngrt4n::Unknown));
 }
 
-QTEST_MAIN(TestStatusAggregation)
+class TestPollingScheduler : public QObject
+{
+  Q_OBJECT
+
+private Q_SLOTS:
+  void test_deadlinesAdvanceByWholePeriods(void);
+  void test_overrunSkipsMissedPeriods(void);
+  void test_viewAddedOnePeriodBackIsDue(void);
+  void test_intervalPrecedence(void);
+  void test_backoffOnFailingSources(void);
+};
+
+namespace {
+  const qint32 INTERVAL = 60;
+  const std::chrono::milliseconds MAX_JITTER(static_cast<long long>(INTERVAL * 1000 * PollingScheduler::START_JITTER_RATIO));
+}
+
+void TestPollingScheduler::test_deadlinesAdvanceByWholePeriods(void)
+{
+  PollingScheduler scheduler(INTERVAL);
+  const auto start = PollingScheduler::ClockT::now();
+  scheduler.addView("view1", start);
+
+  // the first deadline is jittered within a tenth of the interval
+  QVERIFY(scheduler.nextDeadline(start) >= start);
+  QVERIFY(scheduler.nextDeadline(start) <= start + MAX_JITTER);
+  QCOMPARE(scheduler.dueViews(start + MAX_JITTER), QStringList() << "view1");
+
+  // a collection taking some time doesn't shift the next deadline
+  const auto firstDeadline = scheduler.nextDeadline(start);
+  scheduler.markCollected("view1", firstDeadline + std::chrono::seconds(5));
+  QVERIFY(scheduler.nextDeadline(start) == firstDeadline + std::chrono::seconds(INTERVAL));
+  QVERIFY(scheduler.dueViews(firstDeadline + std::chrono::seconds(INTERVAL - 1)).isEmpty());
+}
+
+void TestPollingScheduler::test_overrunSkipsMissedPeriods(void)
+{
+  PollingScheduler scheduler(INTERVAL);
+  const auto start = PollingScheduler::ClockT::now();
+  scheduler.addView("view1", start);
+  const auto firstDeadline = scheduler.nextDeadline(start);
+
+  const auto collectionEnd = firstDeadline + std::chrono::seconds(3 * INTERVAL + 10);
+  scheduler.markCollected("view1", collectionEnd);
+  QVERIFY(scheduler.dueViews(collectionEnd).isEmpty());
+  QVERIFY(scheduler.nextDeadline(collectionEnd) == firstDeadline + std::chrono::seconds(4 * INTERVAL));
+}
+
+void TestPollingScheduler::test_viewAddedOnePeriodBackIsDue(void)
+{
+  // as done by the web sessions, so that their boards are refreshed as soon as they are displayed
+  PollingScheduler scheduler(INTERVAL);
+  const auto now = PollingScheduler::ClockT::now();
+  scheduler.addView("view1", now - std::chrono::seconds(INTERVAL));
+  QCOMPARE(scheduler.dueViews(now), QStringList() << "view1");
+
+  scheduler.markCollected("view1", now);
+  QVERIFY(scheduler.nextDeadline(now) > now);
+  QVERIFY(scheduler.nextDeadline(now) <= now + MAX_JITTER);
+}
+
+void TestPollingScheduler::test_intervalPrecedence(void)
+{
+  PollingScheduler scheduler(INTERVAL);
+  const auto start = PollingScheduler::ClockT::now();
+  scheduler.addView("view1", start);
+  QCOMPARE(scheduler.viewInterval("view1"), INTERVAL);
+
+  QMap<QString, qint32> sourceIntervals;
+  sourceIntervals.insert("Source0", 30);
+  sourceIntervals.insert("Source1", 20);
+  scheduler.setSourceIntervals(sourceIntervals);
+  scheduler.setViewSources("view1", QSet<QString>() << "Source0" << "Source1");
+  QCOMPARE(scheduler.viewInterval("view1"), 20);
+
+  QMap<QString, qint32> viewIntervals;
+  viewIntervals.insert("view1", 90);
+  scheduler.setViewIntervals(viewIntervals);
+  QCOMPARE(scheduler.viewInterval("view1"), 90);
+  QCOMPARE(scheduler.viewInterval("unknown view"), INTERVAL);
+}
+
+void TestPollingScheduler::test_backoffOnFailingSources(void)
+{
+  PollingScheduler scheduler(INTERVAL);
+  const auto start = PollingScheduler::ClockT::now();
+  scheduler.addView("view1", start);
+  scheduler.setViewSources("view1", QSet<QString>() << "Source0" << "Source1");
+
+  // a view is not slowed down while one of its sources answers
+  scheduler.reportSourceFailure("Source0");
+  scheduler.reportSourceFailure("Source0");
+  QCOMPARE(scheduler.backoffFactor("view1"), 1);
+
+  scheduler.reportSourceFailure("Source1");
+  QCOMPARE(scheduler.backoffFactor("view1"), 2);
+  const auto firstDeadline = scheduler.nextDeadline(start);
+  scheduler.markCollected("view1", firstDeadline);
+  QVERIFY(scheduler.nextDeadline(start) == firstDeadline + std::chrono::seconds(2 * INTERVAL));
+
+  for (int failure = 0; failure < 10; ++failure) {
+    scheduler.reportSourceFailure("Source0");
+    scheduler.reportSourceFailure("Source1");
+  }
+  QCOMPARE(scheduler.backoffFactor("view1"), PollingScheduler::MAX_BACKOFF_FACTOR);
+
+  scheduler.reportSourceSuccess("Source1");
+  QCOMPARE(scheduler.backoffFactor("view1"), 1);
+}
+
+class TestSourceCircuitBreaker : public QObject
+{
+  Q_OBJECT
+
+private Q_SLOTS:
+  void test_opensAfterThreshold(void);
+  void test_failuresCountOncePerCycle(void);
+  void test_lastGoodChecks(void);
+};
+
+// the breaker is process-wide, each test uses its own source ids
+
+void TestSourceCircuitBreaker::test_opensAfterThreshold(void)
+{
+  auto& breaker = SourceCircuitBreaker::instance();
+  const QString sid = "TestSource_threshold";
+  quint64 cycle = 1;
+  for (; cycle < SourceCircuitBreaker::FAILURE_THRESHOLD; ++cycle) {
+    breaker.recordFailure(sid, cycle);
+    QVERIFY(! breaker.isOpen(sid));
+  }
+  breaker.recordFailure(sid, cycle);
+  QVERIFY(breaker.isOpen(sid));
+
+  breaker.recordSuccess(sid, QHash<QString, CheckRefT>());
+  QVERIFY(! breaker.isOpen(sid));
+}
+
+void TestSourceCircuitBreaker::test_failuresCountOncePerCycle(void)
+{
+  auto& breaker = SourceCircuitBreaker::instance();
+  const QString sid = "TestSource_cycle";
+
+  // views sharing the source fail one after the other in the same cycle
+  for (int view = 0; view < SourceCircuitBreaker::FAILURE_THRESHOLD; ++view) {
+    breaker.recordFailure(sid, 10);
+  }
+  QVERIFY(! breaker.isOpen(sid));
+
+  // a view of an older cycle finishing late is not counted either
+  breaker.recordFailure(sid, 9);
+  for (quint64 cycle = 11; cycle < 10 + SourceCircuitBreaker::FAILURE_THRESHOLD; ++cycle) {
+    breaker.recordFailure(sid, cycle);
+  }
+  QVERIFY(breaker.isOpen(sid));
+  breaker.recordSuccess(sid, QHash<QString, CheckRefT>());
+
+  // updates outside of a polling cycle are all counted
+  for (int failure = 0; failure < SourceCircuitBreaker::FAILURE_THRESHOLD; ++failure) {
+    breaker.recordFailure(sid, 0);
+  }
+  QVERIFY(breaker.isOpen(sid));
+  breaker.recordSuccess(sid, QHash<QString, CheckRefT>());
+}
+
+void TestSourceCircuitBreaker::test_lastGoodChecks(void)
+{
+  auto& breaker = SourceCircuitBreaker::instance();
+  const QString sid = "TestSource_lastGood";
+
+  CheckRefT check;
+  qint64 staleSince = 0;
+  QVERIFY(! breaker.lastGoodCheck(sid, "host1/cpu", check, staleSince));
+
+  QHash<QString, CheckRefT> checks;
+  checks.insert("Host1/CPU", CheckRefT(CheckT{"Host1/CPU", "Host1", "check_cpu", "0", "CPU OK", "", ngrt4n::Normal}));
+  breaker.recordSuccess(sid, checks);
+  for (int failure = 0; failure < SourceCircuitBreaker::FAILURE_THRESHOLD; ++failure) {
+    breaker.recordFailure(sid, 0);
+  }
+  QVERIFY(breaker.isOpen(sid));
+
+  // data point ids are matched case-insensitively
+  QVERIFY(breaker.lastGoodCheck(sid, "host1/cpu", check, staleSince));
+  QCOMPARE(check->alarm_msg, std::string("CPU OK"));
+  QVERIFY(staleSince > 0);
+  QVERIFY(! breaker.lastGoodCheck(sid, "host1/memory", check, staleSince));
+  breaker.recordSuccess(sid, QHash<QString, CheckRefT>());
+}
+
+class TestViewDependencyGraph : public QObject
+{
+  Q_OBJECT
+
+private Q_SLOTS:
+  void test_waves(void);
+  void test_cycleInLastWave(void);
+};
+
+void TestViewDependencyGraph::test_waves(void)
+{
+  ViewDependencyGraph graph;
+  graph.addView("app", QSet<QString>() << "middleware" << "network");
+  graph.addView("middleware", QSet<QString>() << "network" << "unknown view");
+  graph.addView("network", QSet<QString>() << "network");
+  graph.addView("standalone", QSet<QString>());
+
+  auto waves = graph.evaluationWaves();
+  QCOMPARE(static_cast<int>(waves.size()), 3);
+  QCOMPARE(waves[0], QStringList() << "network" << "standalone");
+  QCOMPARE(waves[1], QStringList() << "middleware");
+  QCOMPARE(waves[2], QStringList() << "app");
+}
+
+void TestViewDependencyGraph::test_cycleInLastWave(void)
+{
+  ViewDependencyGraph graph;
+  graph.addView("base", QSet<QString>());
+  graph.addView("view1", QSet<QString>() << "view2" << "base");
+  graph.addView("view2", QSet<QString>() << "view1");
+  graph.addView("view3", QSet<QString>() << "view1");
+
+  auto waves = graph.evaluationWaves();
+  QCOMPARE(static_cast<int>(waves.size()), 2);
+  QCOMPARE(waves[0], QStringList() << "base");
+  QCOMPARE(waves[1], QStringList() << "view1" << "view2" << "view3");
+}
+
+class TestCheckRegistry : public QObject
+{
+  Q_OBJECT
+
+private Q_SLOTS:
+  void test_unchangedCheckIsShared(void);
+  void test_changedCheckIsRepublished(void);
+  void test_editCopiesSharedCheck(void);
+};
+
+namespace {
+  CheckT makeCheck(int status, const std::string& alarmMsg)
+  {
+    return CheckT{"host1/cpu", "host1", "check_cpu", "0", alarmMsg, "", status};
+  }
+}
+
+void TestCheckRegistry::test_unchangedCheckIsShared(void)
+{
+  auto& registry = CheckRegistry::instance();
+  const auto key = CheckRegistry::dataPointKey("TestSource_shared", "Host1/CPU");
+  QCOMPARE(key, CheckRegistry::dataPointKey("TestSource_shared", "host1/cpu"));
+
+  auto check1 = registry.publish(key, makeCheck(ngrt4n::Normal, "CPU OK"));
+  auto check2 = registry.publish(key, makeCheck(ngrt4n::Normal, "CPU OK"));
+  QCOMPARE(&(*check1), &(*check2));
+}
+
+void TestCheckRegistry::test_changedCheckIsRepublished(void)
+{
+  auto& registry = CheckRegistry::instance();
+  const auto key = CheckRegistry::dataPointKey("TestSource_changed", "host1/cpu");
+
+  auto formerCheck = registry.publish(key, makeCheck(ngrt4n::Normal, "CPU OK"));
+  auto newCheck = registry.publish(key, makeCheck(ngrt4n::Critical, "CPU overloaded"));
+  QVERIFY(&(*formerCheck) != &(*newCheck));
+
+  // references taken before the change keep the former data
+  QCOMPARE(formerCheck->status, static_cast<int>(ngrt4n::Normal));
+  QCOMPARE(newCheck->status, static_cast<int>(ngrt4n::Critical));
+}
+
+void TestCheckRegistry::test_editCopiesSharedCheck(void)
+{
+  auto& registry = CheckRegistry::instance();
+  const auto key = CheckRegistry::dataPointKey("TestSource_edit", "host1/cpu");
+
+  auto sharedCheck = registry.publish(key, makeCheck(ngrt4n::Normal, "CPU OK"));
+  auto editedCheck = sharedCheck;
+  editedCheck.edit().alarm_msg = "edited";
+  QVERIFY(&(*sharedCheck) != &(*editedCheck));
+  QCOMPARE(sharedCheck->alarm_msg, std::string("CPU OK"));
+  QCOMPARE(registry.publish(key, makeCheck(ngrt4n::Normal, "CPU OK"))->alarm_msg, std::string("CPU OK"));
+
+  // a check no longer shared is edited in place
+  auto editedInstance = &(*editedCheck);
+  editedCheck.edit().status = ngrt4n::Major;
+  QCOMPARE(&(*editedCheck), editedInstance);
+}
+
+// runs the test classes of the target one after the other, the exit code counts the failed tests
+int main(int argc, char** argv)
+{
+  QCoreApplication app(argc, argv);
+  int failures = 0;
+
+  TestStatusAggregation statusAggregationTest;
+  failures += QTest::qExec(&statusAggregationTest, argc, argv);
+  TestK8sHelper k8sHelperTest;
+  failures += QTest::qExec(&k8sHelperTest, argc, argv);
+  TestGraphLayout graphLayoutTest;
+  failures += QTest::qExec(&graphLayoutTest, argc, argv);
+  TestStatusJournal statusJournalTest;
+  failures += QTest::qExec(&statusJournalTest, argc, argv);
+  TestPollingScheduler pollingSchedulerTest;
+  failures += QTest::qExec(&pollingSchedulerTest, argc, argv);
+  TestSourceCircuitBreaker sourceCircuitBreakerTest;
+  failures += QTest::qExec(&sourceCircuitBreakerTest, argc, argv);
+  TestViewDependencyGraph viewDependencyGraphTest;
+  failures += QTest::qExec(&viewDependencyGraphTest, argc, argv);
+  TestCheckRegistry checkRegistryTest;
+  failures += QTest::qExec(&checkRegistryTest, argc, argv);
+
+  return failures;
+}
+
 #include "unittests.moc"
 
@@ -29,6 +29,8 @@
 #include "K8sHelper.hpp"
 
 #include <QFileInfo>
+#include <QSaveFile>
+#include <QXmlStreamWriter>
 
 QString ngrt4n::getAbsolutePath(const QString &_path)
 {
@@ -268,6 +270,15 @@ std::pair<int, QString> ngrt4n::loadDynamicViewByGroup(const SourceT &sinfo, con
     return std::make_pair(ngrt4n::RcGenericFailure, QObject::tr("no item found (monitor: %1, filter: %2)").arg(MONITOR_NAME, filter));
   }
 
+  buildDynamicViewByGroup(sinfo, filter, checks, cdata);
+
+  return std::make_pair(ngrt4n::RcSuccess, "");
+}
+
+void ngrt4n::buildDynamicViewByGroup(const SourceT &sinfo, const QString &filter, const ChecksT &checks, CoreDataT &cdata)
+{
+  const auto MONITOR_NAME = MonitorT::toString(sinfo.mon_type);
+
   cdata.clear();
   cdata.monitor = sinfo.mon_type;
   static uint64_t importIndex = 0;
@@ -286,39 +297,33 @@ std::pair<int, QString> ngrt4n::loadDynamicViewByGroup(const SourceT &sinfo, con
   hostNode.type = NodeType::BusinessService;
   itemNode.type = NodeType::ITService;
 
+  // ids are derived from the source, host and check so that successive loads of the same group
+  // yield the same nodes, which lets dynamic views be synchronized in place
   for (ChecksT::ConstIterator check = checks.begin(); check != checks.end(); ++check)
   {
     hostNode.parents = QSet<QString>{rootService.id};
     hostNode.name = hostNode.description = QString::fromStdString(check->host);
-    hostNode.id = "";
+    hostNode.id = dynamicHostId(sinfo.id, hostNode.name);
     hostNode.weight = ngrt4n::WEIGHT_UNIT;
     hostNode.sev_crule = CalcRules::Worst;
     hostNode.sev_prule = PropRules::Unchanged;
 
-    for (auto c : hostNode.name)
-    {
-      if (c.isLetterOrNumber())
-      {
-        hostNode.id.append(c);
-      }
-    }
     QString checkId = QString::fromStdString(check->id);
     itemNode.icon = ngrt4n::GENERIC_CHECK_ICON;
     itemNode.weight = ngrt4n::WEIGHT_UNIT;
     itemNode.sev_crule = CalcRules::Worst;
     itemNode.sev_prule = PropRules::Unchanged;
-    itemNode.id = ngrt4n::generateId();
-    itemNode.parents.insert(hostNode.id);
-    itemNode.name = checkId.startsWith(hostNode.name + "/") ? checkId.mid(hostNode.name.size() + 1) : checkId;
     itemNode.child_nodes = QString::fromStdString("%1:%2").arg(sinfo.id, checkId);
+    itemNode.id = dynamicItemId(itemNode.child_nodes);
+    itemNode.parents = QSet<QString>{hostNode.id};
+    itemNode.name = checkId.startsWith(hostNode.name + "/") ? checkId.mid(hostNode.name.size() + 1) : checkId;
+    itemNode.check = *check;
     cdata.bpnodes.insert(hostNode.id, hostNode);
     cdata.cnodes.insert(itemNode.id, itemNode);
   }
 
   // finally insert the root node and update UI widgets
   cdata.bpnodes.insert(ngrt4n::ROOT_ID, rootService);
-
-  return std::make_pair(ngrt4n::RcSuccess, "");
 }
 
 std::pair<int, QString> ngrt4n::loadDataItems(const SourceT &sinfo, const QString &filter, ChecksT &checks)
@@ -362,53 +367,57 @@ std::pair<int, QString> ngrt4n::saveViewDataToPath(const CoreDataT &cdata, const
   if (!ngrt4n::MonitorSourceTypes.contains(MonitorT::toString(cdata.monitor))) {
     const_cast<CoreDataT &>(cdata).monitor = MonitorT::Any;
   }
-  QFile file(path);
-  if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+  // Stream into a temporary file next to the destination and rename it on commit,
+  // so that a failure in the middle of a large save leaves the previous view intact
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) {
     return std::make_pair(ngrt4n::RcGenericFailure, QObject::tr("Cannot open file: %1").arg(path));
   }
-  QTextStream outStream(&file);
-  outStream << "<?xml version=\"1.0\"?>\n";
-  outStream << QString("<ServiceView compat=\"3.1\" monitor=\"%1\">\n").arg(QString::number(cdata.monitor));
+  QXmlStreamWriter xmlWriter(&file);
+  xmlWriter.setAutoFormatting(true);
+  xmlWriter.setAutoFormattingIndent(1);
+  xmlWriter.writeStartDocument();
+  xmlWriter.writeStartElement("ServiceView");
+  xmlWriter.writeAttribute("compat", "3.1");
+  xmlWriter.writeAttribute("monitor", QString::number(cdata.monitor));
   for (auto &&bpnode : cdata.bpnodes) {
-    outStream << generateNodeXml(bpnode);
+    writeNodeXml(xmlWriter, bpnode);
   }
   for (auto &&cnode : cdata.cnodes) {
     if (!cnode.parents.isEmpty()) {
-      outStream << generateNodeXml(cnode);
+      writeNodeXml(xmlWriter, cnode);
     }
   }
-  outStream << "</ServiceView>\n";
-  file.close();
+  xmlWriter.writeEndElement();
+  xmlWriter.writeEndDocument();
+  if (xmlWriter.hasError()) {
+    file.cancelWriting();
+    return std::make_pair(ngrt4n::RcGenericFailure, QObject::tr("Cannot write file: %1").arg(path));
+  }
+  if (!file.commit()) {
+    return std::make_pair(ngrt4n::RcGenericFailure, QObject::tr("Cannot save file: %1 (%2)").arg(path, file.errorString()));
+  }
   return std::make_pair(ngrt4n::RcSuccess, "");
 }
 
-QString ngrt4n::generateNodeXml(const NodeT &node)
+void ngrt4n::writeNodeXml(QXmlStreamWriter &xmlWriter, const NodeT &node)
 {
-  QString xml = QString("<Service id=\"%1\" "
-                        " type=\"%2\" "
-                        " statusCalcRule=\"%3\" "
-                        " statusPropRule=\"%4\" "
-                        " weight=\"%5\"> \n")
-                    .arg(node.id,
-                         QString::number(node.type),
-                         QString::number(node.sev_crule),
-                         QString::number(node.sev_prule),
-                         QString::number(node.weight));
-
-  xml.append(QString(" <Name>%1</Name>\n").arg(encodeXml(node.name)))
-      .append(QString(" <Icon>%1</Icon>\n").arg(node.icon))
-      .append(QString(" <Description>%1</Description>\n").arg(encodeXml(node.description)))
-      .append(QString(" <AlarmMsg>%1</AlarmMsg>\n").arg(encodeXml(node.alarm_msg)))
-      .append(QString(" <NotificationMsg>%1</NotificationMsg>\n").arg(encodeXml(node.notification_msg)))
-      .append(QString(" <SubServices>%1</SubServices>\n").arg(encodeXml(node.child_nodes)));
-
+  xmlWriter.writeStartElement("Service");
+  xmlWriter.writeAttribute("id", node.id);
+  xmlWriter.writeAttribute("type", QString::number(node.type));
+  xmlWriter.writeAttribute("statusCalcRule", QString::number(node.sev_crule));
+  xmlWriter.writeAttribute("statusPropRule", QString::number(node.sev_prule));
+  xmlWriter.writeAttribute("weight", QString::number(node.weight));
+  xmlWriter.writeTextElement("Name", node.name);
+  xmlWriter.writeTextElement("Icon", node.icon);
+  xmlWriter.writeTextElement("Description", node.description);
+  xmlWriter.writeTextElement("AlarmMsg", node.alarm_msg);
+  xmlWriter.writeTextElement("NotificationMsg", node.notification_msg);
+  xmlWriter.writeTextElement("SubServices", node.child_nodes);
   if (node.sev_crule == CalcRules::WeightedAverageWithThresholds) {
-    xml.append(QString(" <Thresholds>%1</Thresholds>\n").arg(ThresholdHelper::listToData(node.thresholdLimits)));
+    xmlWriter.writeTextElement("Thresholds", ThresholdHelper::listToData(node.thresholdLimits));
   }
-
-  xml.append("</Service>\n");
-
-  return xml;
+  xmlWriter.writeEndElement();
 }
 
 void ngrt4n::fixupDependencies(CoreDataT &cdata)
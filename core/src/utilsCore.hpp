@@ -29,6 +29,8 @@
 #include <QString>
 #include <unistd.h>
 
+class QXmlStreamWriter;
+
 namespace
 {
 const QString SRC_BASENAME = "Source";
@@ -128,6 +130,16 @@ inline QString md5IdFromString(const QString &str)
   return QString("roi_%1").arg(QString(QCryptographicHash::hash((str.toUtf8()), QCryptographicHash::Md5).toHex()));
 }
 
+inline QString dynamicHostId(const QString &sid, const QString &host)
+{
+  return md5IdFromString(QString("host:%1:%2").arg(sid, host));
+}
+
+inline QString dynamicItemId(const QString &dataPointId)
+{
+  return md5IdFromString(QString("item:%1").arg(dataPointId));
+}
+
 inline QString sourceId(const qint32 &idx)
 {
   return QString("%1%2").arg(SRC_BASENAME, QString::number(idx));
@@ -178,11 +190,13 @@ QString basename(const QString &path);
 
 std::pair<int, QString> loadDynamicViewByGroup(const SourceT &sinfo, const QString &filter, CoreDataT &cdata);
 
+void buildDynamicViewByGroup(const SourceT &sinfo, const QString &filter, const ChecksT &checks, CoreDataT &cdata);
+
 std::pair<int, QString> loadDataItems(const SourceT &sinfo, const QString &filter, ChecksT &checks);
 
 std::pair<int, QString> saveViewDataToPath(const CoreDataT &cdata, const QString &path);
 
-QString generateNodeXml(const NodeT &node);
+void writeNodeXml(QXmlStreamWriter &xmlWriter, const NodeT &node);
 
 void fixupDependencies(CoreDataT &cdata);
 
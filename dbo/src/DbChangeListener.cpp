@@ -0,0 +1,200 @@
+/*
+ * DbChangeListener.cpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#include "DbChangeListener.hpp"
+#include "DbSession.hpp"
+#include "WebUtils.hpp"
+#include <libpq-fe.h>
+#include <sys/select.h>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace {
+  const int RECONNECT_DELAY = 5; // seconds
+
+  int cachedDataFromName(const std::string& name)
+  {
+    auto cachedData = std::find(DbSession::CACHED_DATA_NAMES.cbegin(), DbSession::CACHED_DATA_NAMES.cend(), name);
+    if (cachedData == DbSession::CACHED_DATA_NAMES.cend()) {
+      return -1;
+    }
+    return static_cast<int>(cachedData - DbSession::CACHED_DATA_NAMES.cbegin());
+  }
+}
+
+
+DbChangeListener::DbChangeListener(int dbType, const std::string& connectionName)
+  : m_dbType(dbType),
+    m_connectionName(connectionName),
+    m_stopped(false),
+    m_hasVersions(false)
+{
+  for (int cachedData = 0; cachedData < DbSession::CachedDataCount; ++cachedData) {
+    m_polledGenerations.insert(cachedData, DbSession::cachedDataGeneration(cachedData));
+  }
+}
+
+
+DbChangeListener::~DbChangeListener()
+{
+  stop();
+}
+
+
+void DbChangeListener::start(int pollInterval)
+{
+  if (m_thread.joinable()) {
+    return;
+  }
+  m_stopped = false;
+  if (m_dbType == PostgresqlDb) {
+    m_thread = std::thread(&DbChangeListener::listen, this);
+  } else if (pollInterval > 0) {
+    m_thread = std::thread(&DbChangeListener::poll, this, pollInterval);
+  }
+}
+
+
+void DbChangeListener::stop(void)
+{
+  m_stopped = true;
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+
+QSet<int> DbChangeListener::pollChanges(DbSession& dbSession)
+{
+  if (m_dbType != PostgresqlDb) {
+    checkVersions(dbSession);
+  }
+  // derived from the cache generations, so that nothing is left to consume when pollChanges() is never called
+  QSet<int> changes;
+  for (int cachedData = 0; cachedData < DbSession::CachedDataCount; ++cachedData) {
+    quint64 generation = DbSession::cachedDataGeneration(cachedData);
+    if (m_polledGenerations.value(cachedData) != generation) {
+      m_polledGenerations[cachedData] = generation;
+      changes.insert(cachedData);
+    }
+  }
+  return changes;
+}
+
+
+void DbChangeListener::listen(void)
+{
+  while (! m_stopped) {
+    try {
+      Wt::Dbo::backend::Postgres connection(m_connectionName);
+      PGconn* pgConnection = connection.connection();
+      PGresult* result = PQexec(pgConnection, ("LISTEN " + DbSession::CHANGE_CHANNEL).c_str());
+      bool listening = PQresultStatus(result) == PGRES_COMMAND_OK;
+      PQclear(result);
+      if (! listening) {
+        throw std::runtime_error(PQerrorMessage(pgConnection));
+      }
+
+      // changes notified while not listening are lost, everything is reloaded
+      for (int cachedData = 0; cachedData < DbSession::CachedDataCount; ++cachedData) {
+        handleChange(cachedData);
+      }
+
+      while (! m_stopped && PQstatus(pgConnection) == CONNECTION_OK) {
+        int socket = PQsocket(pgConnection);
+        fd_set readFds;
+        FD_ZERO(&readFds);
+        FD_SET(socket, &readFds);
+        timeval timeout{1, 0}; // wakes up every second to check whether the listener is stopped
+        if (select(socket + 1, &readFds, nullptr, nullptr, &timeout) < 0 || ! PQconsumeInput(pgConnection)) {
+          break;
+        }
+        while (PGnotify* notification = PQnotifies(pgConnection)) {
+          // the payload is <cached data name>:<origin>
+          const std::string payload = notification->extra;
+          const auto separator = payload.find(':');
+          int cachedData = cachedDataFromName(payload.substr(0, separator));
+          bool ownChange = separator != std::string::npos && payload.substr(separator + 1) == DbSession::CHANGE_ORIGIN;
+          if (cachedData >= 0 && ! ownChange) {
+            handleChange(cachedData);
+          }
+          PQfreemem(notification);
+        }
+      }
+      if (! m_stopped) {
+        CORE_LOG("error", QObject::tr("lost the connection listening to database changes, reconnecting").toStdString());
+      }
+    } catch (const std::exception& ex) {
+      CORE_LOG("error", QObject::tr("%1: failed listening to database changes (%2)").arg(Q_FUNC_INFO, ex.what()).toStdString());
+    }
+    waitFor(RECONNECT_DELAY);
+  }
+}
+
+
+void DbChangeListener::poll(int pollInterval)
+{
+  DbSession dbSession;
+  do {
+    checkVersions(dbSession);
+  } while (waitFor(pollInterval));
+}
+
+
+void DbChangeListener::checkVersions(DbSession& dbSession)
+{
+  QMap<int, quint64> versions;
+  if (dbSession.listChangeVersions(versions) != ngrt4n::RcSuccess) {
+    return;
+  }
+  if (m_hasVersions) {
+    for (int cachedData = 0; cachedData < DbSession::CachedDataCount; ++cachedData) {
+      // versions bumped only by the process itself are skipped
+      quint64 fromVersion = m_versions.value(cachedData);
+      quint64 toVersion = versions.value(cachedData);
+      int ownChanges = DbSession::takeOwnChanges(cachedData, fromVersion, toVersion);
+      if (toVersion > fromVersion + static_cast<quint64>(ownChanges)) {
+        handleChange(cachedData);
+      }
+    }
+  }
+  m_versions = versions;
+  m_hasVersions = true;
+}
+
+
+void DbChangeListener::handleChange(int cachedData)
+{
+  DbSession::invalidateCachedData(cachedData);
+}
+
+
+bool DbChangeListener::waitFor(int seconds)
+{
+  for (int elapsed = 0; elapsed < seconds && ! m_stopped; ++elapsed) {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+  return ! m_stopped;
+}
@@ -0,0 +1,70 @@
+/*
+ * DbChangeListener.hpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#ifndef DBCHANGELISTENER_HPP
+#define DBCHANGELISTENER_HPP
+
+#include <QMap>
+#include <QSet>
+#include <atomic>
+#include <string>
+#include <thread>
+
+class DbSession;
+
+/**
+ * @brief Tracks the changes of users, views, sources and view assignments made by other processes.
+ * On PostgreSQL a thread listens to the notifications sent by the write paths of DbSession; on SQLite the
+ * counters of the config_version table are compared on each poll. Changes made by the process itself are
+ * skipped, since its write paths already invalidate them. Changed data are invalidated in all the sessions
+ * of the process through DbSession::cachedDataGeneration(), which web sessions follow to rebuild their views
+ * and pollChanges() compares with the generations seen on its previous call.
+ */
+class DbChangeListener
+{
+public:
+  DbChangeListener(int dbType, const std::string& connectionName);
+  ~DbChangeListener();
+
+  void start(int pollInterval); // on SQLite, versions are only checked on pollChanges() when pollInterval is 0
+  void stop(void);
+  QSet<int> pollChanges(DbSession& dbSession);
+
+private:
+  int m_dbType;
+  std::string m_connectionName;
+  std::atomic<bool> m_stopped;
+  std::thread m_thread;
+  QMap<int, quint64> m_polledGenerations; // cache generations seen by the last pollChanges()
+  QMap<int, quint64> m_versions;
+  bool m_hasVersions;
+
+  void listen(void);
+  void poll(int pollInterval);
+  void checkVersions(DbSession& dbSession);
+  void handleChange(int cachedData);
+  bool waitFor(int seconds);
+};
+
+#endif // DBCHANGELISTENER_HPP
@@ -0,0 +1,97 @@
+/*
+ * DbConnectionPool.cpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#include "DbConnectionPool.hpp"
+#include "DbSession.hpp"
+#include <algorithm>
+#include <map>
+
+
+DbConnectionPool::DbConnectionPool(std::unique_ptr<Wt::Dbo::SqlConnection> connection, int size)
+  : m_pool(std::move(connection), size)
+{
+  m_stats.size = size;
+}
+
+
+DbConnectionPool& DbConnectionPool::instance(int dbType, const std::string& connectionName, int size)
+{
+  static QMutex poolsMutex;
+  static std::map<std::string, std::unique_ptr<DbConnectionPool>> pools;
+
+  QMutexLocker locker(&poolsMutex);
+  auto poolKey = std::to_string(dbType) + ":" + connectionName;
+  auto pool = pools.find(poolKey);
+  if (pool == pools.end()) {
+    std::unique_ptr<Wt::Dbo::SqlConnection> connection;
+    switch (dbType) {
+      case PostgresqlDb:
+        connection = std::make_unique<Wt::Dbo::backend::Postgres>(connectionName);
+        break;
+      case Sqlite3Db:
+      default:
+        connection = std::make_unique<Wt::Dbo::backend::Sqlite3>(connectionName);
+        break;
+    }
+    pool = pools.emplace(poolKey, std::unique_ptr<DbConnectionPool>(new DbConnectionPool(std::move(connection), std::max(1, size)))).first;
+  }
+  return *pool->second;
+}
+
+
+std::unique_ptr<Wt::Dbo::SqlConnection> DbConnectionPool::getConnection(void)
+{
+  auto waitStartTime = std::chrono::steady_clock::now();
+  auto connection = m_pool.getConnection();
+  double waitSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - waitStartTime).count();
+
+  QMutexLocker locker(&m_statsMutex);
+  ++m_stats.inUse;
+  ++m_stats.acquisitions;
+  m_stats.peakInUse = std::max(m_stats.peakInUse, m_stats.inUse);
+  m_stats.waitSeconds += waitSeconds;
+  return connection;
+}
+
+
+void DbConnectionPool::returnConnection(std::unique_ptr<Wt::Dbo::SqlConnection> connection)
+{
+  m_pool.returnConnection(std::move(connection));
+
+  QMutexLocker locker(&m_statsMutex);
+  --m_stats.inUse;
+}
+
+
+void DbConnectionPool::prepareForDropTables(void) const
+{
+  m_pool.prepareForDropTables();
+}
+
+
+DbConnectionPool::StatsT DbConnectionPool::stats(void) const
+{
+  QMutexLocker locker(&m_statsMutex);
+  return m_stats;
+}
@@ -0,0 +1,67 @@
+/*
+ * DbConnectionPool.hpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#ifndef DBCONNECTIONPOOL_HPP
+#define DBCONNECTIONPOOL_HPP
+
+#include <Wt/Dbo/FixedSqlConnectionPool.h>
+#include <Wt/Dbo/SqlConnection.h>
+#include <QMutex>
+#include <chrono>
+#include <memory>
+#include <string>
+
+
+/**
+ * @brief Pool of database connections shared by all the sessions of the process.
+ * There's one pool per database configuration, created on first use and kept for the lifetime of the process.
+ * Connections are only held for the duration of a transaction; usage metrics are kept to size the pool.
+ */
+class DbConnectionPool : public Wt::Dbo::SqlConnectionPool
+{
+public:
+  struct StatsT {
+    int size = 0;
+    int inUse = 0;
+    int peakInUse = 0;
+    quint64 acquisitions = 0;
+    double waitSeconds = 0; // cumulated time spent waiting for a free connection
+  };
+
+  static DbConnectionPool& instance(int dbType, const std::string& connectionName, int size);
+
+  std::unique_ptr<Wt::Dbo::SqlConnection> getConnection(void) override;
+  void returnConnection(std::unique_ptr<Wt::Dbo::SqlConnection> connection) override;
+  void prepareForDropTables(void) const override;
+  StatsT stats(void) const;
+
+private:
+  Wt::Dbo::FixedSqlConnectionPool m_pool;
+  mutable QMutex m_statsMutex;
+  StatsT m_stats;
+
+  DbConnectionPool(std::unique_ptr<Wt::Dbo::SqlConnection> connection, int size);
+};
+
+#endif // DBCONNECTIONPOOL_HPP
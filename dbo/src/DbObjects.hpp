@@ -211,11 +211,25 @@ struct PlatformStatusT {
   float critical;
   float unknown;
   std::string view_name;
-
-  PlatformStatusT() : status(ngrt4n::Unknown) {}
-
+  long resolution; // 0 for a raw sample, otherwise the length of the rollup bucket starting at timestamp
+  long normal_duration; // time spent in each status within the rollup bucket
+  long minor_duration;
+  long major_duration;
+  long critical_duration;
+  long unknown_duration;
+
+  PlatformStatusT()
+    : status(ngrt4n::Unknown),
+      resolution(0),
+      normal_duration(0),
+      minor_duration(0),
+      major_duration(0),
+      critical_duration(0),
+      unknown_duration(0) {}
+
+  /** CSV row, the resolution tells a rollup bucket average from a raw sample */
   std::string toString(void) const {
-    return QString("%1,%2,%3,%4,%5,%6,%7,%8")
+    return QString("%1,%2,%3,%4,%5,%6,%7,%8,%9")
         .arg(QString::number(timestamp),
              view_name.c_str(),
              QString::number(status),
@@ -223,7 +237,68 @@ struct PlatformStatusT {
              QString::number(static_cast<double>(minor)),
              QString::number(static_cast<double>(major)),
              QString::number(static_cast<double>(critical)),
-             QString::number(static_cast<double>(unknown))).toStdString();
+             QString::number(static_cast<double>(unknown)),
+             QString::number(resolution)).toStdString();
+  }
+};
+
+
+/** position of a forward-only read of the status history, see DbSession::fetchStatusHistory */
+struct StatusHistoryCursorT {
+  std::string view; // empty or "ALL" for all views
+  long startDate;
+  long endDate;
+  long resolution; // rollup tier read before the raw samples, 0 for none, -1 until the first read
+  bool rollupsDone;
+  std::string lastView; // key of the last rollup read
+  long lastRollupTimestamp;
+  long lastTimestamp; // key of the last raw sample read
+  long long lastId;
+  bool atEnd;
+
+  StatusHistoryCursorT(const std::string& _view, long _startDate, long _endDate)
+    : view(_view),
+      startDate(_startDate),
+      endDate(_endDate),
+      resolution(-1),
+      rollupsDone(false),
+      lastRollupTimestamp(-1),
+      lastTimestamp(_startDate),
+      lastId(-1),
+      atEnd(false) {}
+};
+
+
+/** time spent in each status over a period, in seconds */
+struct StatusDurationsT {
+  long normal = 0;
+  long minor = 0;
+  long major = 0;
+  long critical = 0;
+  long unknown = 0;
+
+  long total(void) const {
+    return normal + minor + major + critical + unknown;
+  }
+
+  void add(int status, long duration) {
+    switch (status) {
+      case ngrt4n::Normal:
+        normal += duration;
+        break;
+      case ngrt4n::Minor:
+        minor += duration;
+        break;
+      case ngrt4n::Major:
+        major += duration;
+        break;
+      case ngrt4n::Critical:
+        critical += duration;
+        break;
+      default:
+        unknown += duration;
+        break;
+    }
   }
 };
 
@@ -406,6 +481,8 @@ typedef std::list<DboView> DbViewsT;
 typedef std::list<DboLoginSession> LoginSessionListT;
 typedef std::list<PlatformStatusT> ListofPlatformStatusT;
 typedef QMap<std::string, ListofPlatformStatusT > PlatformMappedStatusHistoryT;
+typedef QMap<std::string, PlatformStatusT> PlatformStatusMapT;
+typedef QMap<std::string, StatusDurationsT> StatusDurationMapT;
 typedef QMap<std::string, NotificationT> NotificationMapT;
 typedef dbo::collection< dbo::ptr<DboUser> > DboUserCollectionT;
 typedef dbo::collection< dbo::ptr<DboView> > DboViewCollectionT;
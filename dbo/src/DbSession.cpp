@@ -23,13 +23,21 @@
  */
 #include "WebUtils.hpp"
 #include "DbSession.hpp"
+#include "DbConnectionPool.hpp"
 #include "WebBaseSettings.hpp"
 #include <tuple>
 #include <regex>
 #include <QFile>
+#include <QCoreApplication>
 #include <Wt/Auth/Identity.h>
 #include <Wt/Auth/PasswordStrengthValidator.h>
 #include <Wt/Dbo/Exception.h>
+#include <algorithm>
+#include <ctime>
+#include <map>
+#include <random>
+#include <set>
+#include <QMutex>
 
 namespace Wt
 {
@@ -47,24 +55,113 @@ namespace Wt
   }
 }
 
+namespace {
+  const long STATUS_HISTORY_MIN_POINTS = 200;    // a rollup tier is only used if it yields at least this number of points
+  const long STATUS_ROLLUP_CHUNK_BUCKETS = 2016; // buckets rolled up per view and tier on each update, bounds the backfill
+  const long STATUS_PURGE_CHUNK = 86400;         // expired data is deleted one day at a time...
+  const int STATUS_PURGE_MAX_CHUNKS = 24;        // ...and for a limited number of days per purge
+  const size_t STATUS_INSERT_BATCH_ROWS = 100;   // rows per INSERT statement, keeps the bound parameters under the SQLite limit
+
+  struct StatusRollupT {
+    long sampleCount = 0;
+    double ratios[ngrt4n::Unknown + 1] = {}; // sums of the normal to unknown ratios, weighted by sample count
+    long durations[ngrt4n::Unknown + 1] = {};
+  };
+  typedef QMap<long, StatusRollupT> StatusRollupsT; // by bucket start
+
+  typedef std::tuple<std::string, long, int, float, float, float, float, float> CurrentStatusT;
+  const std::string CURRENT_STATUS_SQL = "SELECT view_name, timestamp, status, normal, minor, major, critical, unknown"
+                                         " FROM qosdata_current";
+
+  PlatformStatusT currentStatusData(const CurrentStatusT& entry)
+  {
+    PlatformStatusT data;
+    data.view_name = std::get<0>(entry);
+    data.timestamp = std::get<1>(entry);
+    data.status = std::get<2>(entry);
+    data.normal = std::get<3>(entry);
+    data.minor = std::get<4>(entry);
+    data.major = std::get<5>(entry);
+    data.critical = std::get<6>(entry);
+    data.unknown = std::get<7>(entry);
+    return data;
+  }
+
+  typedef std::tuple<std::string, long, int, float, float, float, float, float, long, long, long, long, long> RollupStatusT;
+  const std::string ROLLUP_STATUS_SQL = "SELECT view_name, timestamp, status, normal, minor, major, critical, unknown,"
+                                        " normal_duration, minor_duration, major_duration, critical_duration, unknown_duration"
+                                        " FROM qosdata_rollup";
+
+  PlatformStatusT rollupStatusData(const RollupStatusT& entry, long resolution)
+  {
+    PlatformStatusT data;
+    data.view_name = std::get<0>(entry);
+    data.timestamp = std::get<1>(entry);
+    data.status = std::get<2>(entry);
+    data.normal = std::get<3>(entry);
+    data.minor = std::get<4>(entry);
+    data.major = std::get<5>(entry);
+    data.critical = std::get<6>(entry);
+    data.unknown = std::get<7>(entry);
+    data.resolution = resolution;
+    data.normal_duration = std::get<8>(entry);
+    data.minor_duration = std::get<9>(entry);
+    data.major_duration = std::get<10>(entry);
+    data.critical_duration = std::get<11>(entry);
+    data.unknown_duration = std::get<12>(entry);
+    return data;
+  }
+
+  // selects the raw samples of a view recorded after its last rollup bucket within the range, or from the start
+  // of the range when the view has no bucket; binds tier, rollup start, end, tier and range start
+  const std::string RAW_TAIL_CONDITION = "timestamp >= COALESCE((SELECT MAX(r.timestamp) FROM qosdata_rollup r"
+                                         " WHERE r.tier = ? AND r.view_name = qosdata.view_name"
+                                         " AND r.timestamp >= ? AND r.timestamp <= ?) + ?, ?)";
+
+  // tables reread from the database when the related cached data are stale
+  const std::vector<const char*> CACHED_DATA_TABLES[DbSession::CachedDataCount] = {
+    {"user", "auth_info"},
+    {"view"},
+    {"data_source"},
+    {"user", "view"}
+  };
+
+  void addStatusDuration(StatusRollupsT& rollups, long resolution, int status, long begin, long end)
+  {
+    if (status < ngrt4n::Normal || status > ngrt4n::Unknown) {
+      status = ngrt4n::Unknown;
+    }
+    while (begin < end) {
+      long bucketEnd = std::min(begin - begin % resolution + resolution, end);
+      rollups[begin - begin % resolution].durations[status] += bucketEnd - begin;
+      begin = bucketEnd;
+    }
+  }
+}
+
+
+const std::vector<long> DbSession::STATUS_ROLLUP_RESOLUTIONS = {300, 3600, 86400};
+const std::vector<std::string> DbSession::CACHED_DATA_NAMES = {"users", "views", "sources", "view_assignments"};
+const std::string DbSession::CHANGE_CHANNEL = "realopinsight_changes";
+const std::string DbSession::CHANGE_ORIGIN = QString("%1-%2").arg(QCoreApplication::applicationPid()).arg(std::random_device{}()).toStdString();
+
+
 DbSession::DbSession()
-  : m_dbIsReady(false)
+  : m_dbIsReady(false),
+    m_statusTablesReady(false),
+    m_changeTableReady(false),
+    m_dbType(Sqlite3Db),
+    m_cacheGenerations{},
+    m_connectionPool(nullptr)
 {
   m_usersDb = new UserDatabase(*this);
   m_passAuthService = new Wt::Auth::PasswordService(m_basicAuthService);
   WebBaseSettings settings;
+  m_dbType = settings.getDbType();
   try
   {
-    switch (settings.getDbType())
-    {
-      case PostgresqlDb:
-        setConnection(std::make_unique<Wt::Dbo::backend::Postgres>(settings.getDbConnectionName()));
-        break;
-      case Sqlite3Db:
-      default:
-        setConnection(std::make_unique<Wt::Dbo::backend::Sqlite3>(settings.getDbConnectionName()));
-        break;
-    }
+    m_connectionPool = &DbConnectionPool::instance(settings.getDbType(), settings.getDbConnectionName(), settings.getDbConnectionPoolSize());
+    setConnectionPool(*m_connectionPool);
     configureAuth();
     setupDbMapping();
     m_dbIsReady = true;
@@ -82,6 +179,133 @@ DbSession::~DbSession()
   delete m_passAuthService;
 }
 
+std::atomic<quint64>& DbSession::cacheGeneration(int cachedData)
+{
+  static std::atomic<quint64> generations[CachedDataCount] = {{1}, {1}, {1}, {1}};
+  return generations[cachedData];
+}
+
+namespace {
+  QMutex ownVersionsMutex;
+  std::set<quint64> ownVersions[DbSession::CachedDataCount]; // versions written by the process, by cached data
+  const size_t MAX_OWN_VERSIONS = 1024; // bounds the set when no listener takes them
+}
+
+void DbSession::recordOwnChange(int cachedData, quint64 version)
+{
+  QMutexLocker locker(&ownVersionsMutex);
+  auto& versions = ownVersions[cachedData];
+  versions.insert(version);
+  if (versions.size() > MAX_OWN_VERSIONS) {
+    versions.erase(versions.begin());
+  }
+}
+
+int DbSession::takeOwnChanges(int cachedData, quint64 fromVersion, quint64 toVersion)
+{
+  QMutexLocker locker(&ownVersionsMutex);
+  int count = 0;
+  auto& versions = ownVersions[cachedData];
+  for (auto version = versions.begin(); version != versions.end() && *version <= toVersion;) {
+    // versions recorded after the listener read them are dropped without being counted
+    if (*version > fromVersion) {
+      ++count;
+    }
+    version = versions.erase(version);
+  }
+  return count;
+}
+
+void DbSession::invalidateCachedData(int cachedData)
+{
+  ++cacheGeneration(cachedData);
+}
+
+quint64 DbSession::reloadCachedData(int cachedData)
+{
+  quint64 generation = cacheGeneration(cachedData).load();
+  for (const auto& table: CACHED_DATA_TABLES[cachedData]) {
+    rereadAll(table);
+  }
+  return generation;
+}
+
+void DbSession::publishChange(int cachedData)
+{
+  invalidateCachedData(cachedData);
+  ensureChangeTable();
+  long long version = 0;
+  dbo::Transaction transaction(*this);
+  try
+  {
+    execute("INSERT INTO config_version (name, version) VALUES (?, 1)"
+            " ON CONFLICT (name) DO UPDATE SET version = config_version.version + 1")
+        .bind(CACHED_DATA_NAMES[cachedData]);
+    // the row stays locked until the commit, so the version read back is the one written here
+    version = query<long long>("SELECT version FROM config_version WHERE name = ?")
+        .bind(CACHED_DATA_NAMES[cachedData]).resultValue();
+    if (m_dbType == PostgresqlDb) {
+      // delivered to the listening processes when the transaction commits, the origin lets this process skip its own changes
+      execute(QString("NOTIFY %1, '%2:%3'").arg(CHANGE_CHANNEL.c_str(), CACHED_DATA_NAMES[cachedData].c_str(), CHANGE_ORIGIN.c_str()).toStdString());
+    }
+  }
+  catch (const dbo::Exception &ex)
+  {
+    CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
+  }
+  // PostgreSQL notifications carry their origin, only the polled versions need to be remembered
+  if (transaction.commit() && version > 0 && m_dbType != PostgresqlDb) {
+    recordOwnChange(cachedData, static_cast<quint64>(version));
+  }
+}
+
+int DbSession::listChangeVersions(QMap<int, quint64>& versions)
+{
+  int rc = ngrt4n::RcDbError;
+  ensureChangeTable();
+  dbo::Transaction transaction(*this);
+  try
+  {
+    dbo::collection<std::tuple<std::string, long long>>
+        results = query<std::tuple<std::string, long long>>("SELECT name, version FROM config_version");
+    versions.clear();
+    for (const auto& entry: results) {
+      auto cachedData = std::find(CACHED_DATA_NAMES.cbegin(), CACHED_DATA_NAMES.cend(), std::get<0>(entry));
+      if (cachedData != CACHED_DATA_NAMES.cend()) {
+        versions.insert(static_cast<int>(cachedData - CACHED_DATA_NAMES.cbegin()), static_cast<quint64>(std::get<1>(entry)));
+      }
+    }
+    rc = ngrt4n::RcSuccess;
+  }
+  catch (const dbo::Exception &ex)
+  {
+    CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
+  }
+  transaction.commit();
+  return rc;
+}
+
+void DbSession::ensureChangeTable(void)
+{
+  if (m_changeTableReady) {
+    return;
+  }
+
+  dbo::Transaction transaction(*this);
+  try
+  {
+    execute("CREATE TABLE IF NOT EXISTS config_version ("
+            " name text NOT NULL PRIMARY KEY,"
+            " version bigint NOT NULL)");
+    m_changeTableReady = true;
+  }
+  catch (const dbo::Exception &ex)
+  {
+    CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
+  }
+  transaction.commit();
+}
+
 
 void DbSession::setupDbMapping(void)
 {
@@ -129,6 +353,8 @@ DbSession::addUser(const DboUserT &userInfo)
     CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
   }
   transaction.commit();
+  publishChange(CachedUsers);
+  publishChange(CachedViewAssignments);
 
   return out;
 }
@@ -160,6 +386,8 @@ DbSession::updateUser(const DboUserT &userInfo)
     CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
   }
   transaction.commit();
+  publishChange(CachedUsers);
+  publishChange(CachedViewAssignments);
 
   return out;
 }
@@ -196,6 +424,7 @@ DbSession::updatePassword(const std::string &uname, const std::string &currentPa
     CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
   }
   transaction.commit();
+  publishChange(CachedUsers);
 
   return out;
 }
@@ -216,6 +445,8 @@ int DbSession::deleteUser(const std::string &username)
     CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
   }
   transaction.commit();
+  publishChange(CachedUsers);
+  publishChange(CachedViewAssignments);
   return rc;
 }
 
@@ -235,6 +466,8 @@ int DbSession::deleteAuthSystemUsers(int authSystem)
     CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
   }
   transaction.commit();
+  publishChange(CachedUsers);
+  publishChange(CachedViewAssignments);
   return retValue;
 }
 
@@ -274,6 +507,7 @@ void DbSession::configureAuth(void)
 
 void DbSession::decodeLoggedUser(void)
 {
+  reloadCachedData(CachedUsers);
   dbo::Transaction transaction(*this);
   try
   {
@@ -290,7 +524,12 @@ void DbSession::decodeLoggedUser(void)
 
 DbUsersT DbSession::listUsers(void)
 {
+  if (isCached(CachedUsers)) {
+    return m_usersCache;
+  }
+
   DbUsersT ulist;
+  quint64 generation = reloadCachedData(CachedUsers);
   dbo::Transaction transaction(*this);
   try
   {
@@ -302,6 +541,8 @@ DbUsersT DbSession::listUsers(void)
         ulist.push_back(*user);
       }
     }
+    m_usersCache = ulist;
+    m_cacheGenerations[CachedUsers] = generation;
   }
   catch (const dbo::Exception &ex)
   {
@@ -314,7 +555,12 @@ DbUsersT DbSession::listUsers(void)
 
 DbViewsT DbSession::listViews(void)
 {
+  if (isCached(CachedViews)) {
+    return m_viewsCache;
+  }
+
   DbViewsT vlist;
+  quint64 generation = reloadCachedData(CachedViews);
   dbo::Transaction transaction(*this);
   try
   {
@@ -326,6 +572,8 @@ DbViewsT DbSession::listViews(void)
         vlist.push_back(*view);
       }
     }
+    m_viewsCache = vlist;
+    m_cacheGenerations[CachedViews] = generation;
   }
   catch (const dbo::Exception &ex)
   {
@@ -339,27 +587,48 @@ DbViewsT DbSession::listViews(void)
 
 DbViewsT DbSession::listAssignedViewsByUser(const std::string &uname)
 {
-  DbViewsT vlist;
+  loadViewAssignments();
+  auto userViews = m_assignedViewsCache.find(uname);
+  if (userViews == m_assignedViewsCache.end()) {
+    return DbViewsT();
+  }
+  return userViews->second;
+}
+
+void DbSession::loadViewAssignments(void)
+{
+  if (isCached(CachedViewAssignments)) {
+    return;
+  }
+
+  quint64 generation = reloadCachedData(CachedViewAssignments);
+  m_assignedViewsCache.clear();
+  m_userViewsCache.clear();
   dbo::Transaction transaction(*this);
   try
   {
-    dbo::ptr<DboUser> userDboPtr = find<DboUser>().where("name=?").bind(uname);
-    for (auto &view : userDboPtr.modify()->views)
+    DboUserCollectionT users = find<DboUser>();
+    for (auto &user : users)
     {
-      if (view.get())
+      auto &userViews = m_assignedViewsCache[user->username];
+      for (const auto &view : user->views)
       {
-        vlist.push_back(*view);
+        if (view.get())
+        {
+          userViews.push_back(*view);
+          m_userViewsCache.insert(user->username + ":" + view->name);
+        }
       }
     }
+    m_cacheGenerations[CachedViewAssignments] = generation;
   }
   catch (const dbo::Exception &ex)
   {
-    vlist.clear();
+    m_assignedViewsCache.clear();
+    m_userViewsCache.clear();
     CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
   }
   transaction.commit();
-
-  return vlist;
 }
 
 bool DbSession::findView(const std::string &vname, DboView &view)
@@ -381,6 +650,8 @@ int DbSession::initDb(void)
   try
   {
     createTables();
+    ensureStatusTables();
+    ensureChangeTable();
     DboUserT adm;
     adm.username = "admin";
     adm.password = "password";
@@ -436,6 +707,8 @@ DbSession::addView(const DboView &vInfo)
     CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
   }
   transaction.commit();
+  publishChange(CachedViews);
+  publishChange(CachedViewAssignments);
 
   return out;
 }
@@ -460,6 +733,8 @@ DbSession::updateViewWithPath(const DboView &vinfo, const std::string &vpath)
     CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
   }
   transaction.commit();
+  publishChange(CachedViews);
+  publishChange(CachedViewAssignments);
 
   return out;
 }
@@ -486,25 +761,16 @@ DbSession::deleteViewWithName(const std::string &vname)
     CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
   }
   transaction.commit();
+  publishChange(CachedViews);
+  publishChange(CachedViewAssignments);
 
   return out;
 }
 
 UserViewsT DbSession::updateUserViewList(void)
 {
-  UserViewsT userViewList;
-  dbo::Transaction transaction(*this);
-  DboUserCollectionT users = find<DboUser>();
-  for (auto &user : users)
-  {
-    for (const auto &view : user->views)
-    {
-      userViewList.insert(user->username + ":" + view->name);
-    }
-  }
-  transaction.commit();
-
-  return userViewList;
+  loadViewAssignments();
+  return m_userViewsCache;
 }
 
 std::pair<int, QString>
@@ -530,6 +796,7 @@ DbSession::assignView(const std::string &userId, const std::string &vname)
     CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
   }
   transaction.commit();
+  publishChange(CachedViewAssignments);
 
   return out;
 }
@@ -557,6 +824,7 @@ DbSession::revokeView(const std::string &userId, const std::string &viewId)
     CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
   }
   transaction.commit();
+  publishChange(CachedViewAssignments);
 
   return out;
 }
@@ -567,15 +835,12 @@ int DbSession::listAssignedUsersEmails(QStringList &emails, const std::string &v
   dbo::Transaction transaction(*this);
   try
   {
-    std::string sql = QString("SELECT user.email"
-                              " FROM user, user_view"
-                              " WHERE user.name = user_view.user_name"
-                              "   AND user_view.view_name = '%1'"
-                              "   AND user.email != ''")
-        .arg(vname.c_str())
-        .toStdString();
-
-    dbo::collection<std::string> results = query<std::string>(sql);
+    dbo::collection<std::string> results = query<std::string>("SELECT user.email"
+                                                              " FROM user, user_view"
+                                                              " WHERE user.name = user_view.user_name"
+                                                              "   AND user_view.view_name = ?"
+                                                              "   AND user.email != ''")
+        .bind(vname);
     emails.clear();
     for (const auto &entry : results) {
       emails.push_back(QString::fromStdString(entry));
@@ -637,57 +902,119 @@ int DbSession::checkUserCookie(const DboLoginSession &session)
 
 int DbSession::addPlatformStatus(const PlatformStatusT &platformStatus)
 {
-  int retValue = ngrt4n::RcGenericFailure;
-  dbo::Transaction transaction(*this);
-  try
-  {
-    auto pfsInfo = std::make_unique<DboPlatformStatus>();
-    pfsInfo->setData(platformStatus);
-    pfsInfo->view = find<DboView>().where("name=?").bind(platformStatus.view_name);
-    if (pfsInfo->view.get() != nullptr) {
-      dbo::ptr<DboPlatformStatus> dboEntry = add(std::move(pfsInfo));
-      retValue = ngrt4n::RcSuccess;
-    } else {
-      retValue = ngrt4n::RcDbError;
-      REPORTD_LOG("error", QObject::tr("%1: Cannot find view: %2").arg(Q_FUNC_INFO, platformStatus.view_name.c_str()).toStdString());
-    }
-  }
-  catch (const dbo::Exception &ex) {
-    REPORTD_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
-  }
-  transaction.commit();
-  return retValue;
+  return addPlatformStatusList(ListofPlatformStatusT{platformStatus}).first;
 }
 
+/**
+ * Inserts the entries in a single transaction, with multi-row INSERT statements.
+ * View names, which are the keys of qosdata, are checked against the cached view list, which follows
+ * the changes of the other processes; entries of views that no longer exist are skipped. A view deleted
+ * after the check fails the transaction, which is then retried once with the view list reloaded.
+ */
 std::pair<int, QString>
 DbSession::addPlatformStatusList(const ListofPlatformStatusT &platformStatusList)
 {
-  std::pair<int, QString> out{ngrt4n::RcDbError, ""};
+  std::pair<int, QString> out{ngrt4n::RcSuccess, ""};
+  ensureStatusTables();
 
-  dbo::Transaction transaction(*this);
-  try
-  {
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    if (attempt > 0) {
+      m_cacheGenerations[CachedViews] = 0;
+    }
+    std::set<std::string> viewNames;
+    for (const auto& view: listViews()) {
+      viewNames.insert(view.name);
+    }
+    std::vector<const PlatformStatusT*> entries;
+    std::set<std::string> unknownViews;
     for (const auto &pfsItem : platformStatusList) {
-      auto dboPFS = std::make_unique<DboPlatformStatus>();
-      dboPFS->setData(pfsItem);
-      dboPFS->view = find<DboView>().where("name=?").bind(pfsItem.view_name);
-      dbo::ptr<DboPlatformStatus> dboEntry = add(std::move(dboPFS));
-      out.second.append(QString("Platform status entry added: %1").arg(dboEntry->toString().c_str()));
+      if (viewNames.find(pfsItem.view_name) != viewNames.end()) {
+        entries.push_back(&pfsItem);
+      } else {
+        unknownViews.insert(pfsItem.view_name);
+      }
     }
-    out.first = 0;
-  }
-  catch (const dbo::Exception &ex)
-  {
-    out.second = "Failed to add platform status entries to database.";
-    CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
+    for (const auto& viewName: unknownViews) {
+      REPORTD_LOG("notice", QObject::tr("%1: skipping the status entries of a view that no longer exists: %2").arg(Q_FUNC_INFO, viewName.c_str()).toStdString());
+    }
+
+    out = {ngrt4n::RcSuccess, ""};
+    dbo::Transaction transaction(*this);
+    try
+    {
+      for (size_t first = 0; first < entries.size(); first += STATUS_INSERT_BATCH_ROWS) {
+        size_t last = std::min(first + STATUS_INSERT_BATCH_ROWS, entries.size());
+        std::string sql = "INSERT INTO qosdata (version, timestamp, view_name, status, normal, minor, major, critical, unknown) VALUES ";
+        for (size_t index = first; index < last; ++index) {
+          sql.append(index > first ? ", (0, ?, ?, ?, ?, ?, ?, ?, ?)" : "(0, ?, ?, ?, ?, ?, ?, ?, ?)");
+        }
+        auto insertCall = execute(sql);
+        for (size_t index = first; index < last; ++index) {
+          insertCall.bind(entries[index]->timestamp)
+              .bind(entries[index]->view_name)
+              .bind(entries[index]->status)
+              .bind(entries[index]->normal)
+              .bind(entries[index]->minor)
+              .bind(entries[index]->major)
+              .bind(entries[index]->critical)
+              .bind(entries[index]->unknown);
+        }
+        insertCall.run();
+      }
+
+      // the current status of each view is updated in the same transaction, with the latest of its entries
+      std::map<std::string, const PlatformStatusT*> currentEntries;
+      for (const auto entry: entries) {
+        auto currentEntry = currentEntries.find(entry->view_name);
+        if (currentEntry == currentEntries.end() || currentEntry->second->timestamp <= entry->timestamp) {
+          currentEntries[entry->view_name] = entry;
+        }
+      }
+      for (const auto& currentEntry: currentEntries) {
+        const auto entry = currentEntry.second;
+        execute("INSERT INTO qosdata_current (view_name, timestamp, status, normal, minor, major, critical, unknown)"
+                " VALUES (?, ?, ?, ?, ?, ?, ?, ?)"
+                " ON CONFLICT (view_name) DO UPDATE SET timestamp = excluded.timestamp, status = excluded.status,"
+                "   normal = excluded.normal, minor = excluded.minor, major = excluded.major,"
+                "   critical = excluded.critical, unknown = excluded.unknown"
+                " WHERE excluded.timestamp >= qosdata_current.timestamp")
+            .bind(entry->view_name)
+            .bind(entry->timestamp)
+            .bind(entry->status)
+            .bind(entry->normal)
+            .bind(entry->minor)
+            .bind(entry->major)
+            .bind(entry->critical)
+            .bind(entry->unknown);
+      }
+      out.second = QObject::tr("%1 platform status entries added").arg(entries.size());
+      if (! unknownViews.empty()) {
+        out.second.append(QObject::tr(", %1 skipped for views that no longer exist").arg(platformStatusList.size() - entries.size()));
+      }
+    }
+    catch (const dbo::Exception &ex)
+    {
+      out.first = ngrt4n::RcDbError;
+      out.second = "Failed to add platform status entries to database.";
+      REPORTD_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
+    }
+    if (out.first == ngrt4n::RcSuccess) {
+      transaction.commit();
+      break;
+    }
+    transaction.rollback();
   }
-  transaction.commit();
 
   return out;
 }
 
 int DbSession::listStatusHistory(PlatformMappedStatusHistoryT& statusHistory, const std::string& view, long startDate, long endDate)
 {
+  long resolution = statusHistoryResolution(startDate, endDate);
+  if (resolution > 0) {
+    return listStatusRollups(statusHistory, view, resolution, startDate, endDate);
+  }
+
   int count = 0;
   dbo::Transaction transaction(*this);
   try
@@ -724,26 +1051,101 @@ int DbSession::listStatusHistory(PlatformMappedStatusHistoryT& statusHistory, co
   return count;
 }
 
+/**
+ * Reads the next entries of the cursor's range. When the range is long enough for a rollup tier, the
+ * buckets of that tier are read first by keyset on (view_name, timestamp), followed by the raw samples
+ * recorded after the last bucket of each view. Raw samples are read by keyset on (timestamp, id), so
+ * each call costs an index range scan whatever the position in the range.
+ * Returns the number of entries read, or -1 on error.
+ */
+int DbSession::fetchStatusHistory(StatusHistoryCursorT& cursor, ListofPlatformStatusT& entries, int maxEntries)
+{
+  ensureStatusTables();
+
+  int count = 0;
+  entries.clear();
+  if (cursor.atEnd) {
+    return count;
+  }
+
+  if (cursor.resolution < 0) {
+    cursor.resolution = statusHistoryResolution(cursor.startDate, cursor.endDate);
+    cursor.rollupsDone = (cursor.resolution == 0);
+  }
+
+  dbo::Transaction transaction(*this);
+  try
+  {
+    const bool allViews = cursor.view.empty() || cursor.view == "ALL";
+    const long rollupStart = cursor.resolution > 0 ? cursor.startDate - cursor.startDate % cursor.resolution : cursor.startDate;
+    if (! cursor.rollupsDone) {
+      auto rollupQuery = query<RollupStatusT>(ROLLUP_STATUS_SQL)
+          .where("tier = ? AND timestamp >= ? AND timestamp <= ?")
+          .bind(cursor.resolution).bind(rollupStart).bind(cursor.endDate)
+          .where("(view_name > ? OR (view_name = ? AND timestamp > ?))")
+          .bind(cursor.lastView).bind(cursor.lastView).bind(cursor.lastRollupTimestamp);
+      if (! allViews) {
+        rollupQuery.where("view_name = ?").bind(cursor.view);
+      }
+      dbo::collection<RollupStatusT> rollups = rollupQuery.orderBy("view_name, timestamp").limit(maxEntries);
+      for (const auto& rollup: rollups) {
+        entries.push_back(rollupStatusData(rollup, cursor.resolution));
+        cursor.lastView = entries.back().view_name;
+        cursor.lastRollupTimestamp = entries.back().timestamp;
+        ++count;
+      }
+      cursor.rollupsDone = (count < maxEntries);
+    }
+
+    if (cursor.rollupsDone && count < maxEntries) {
+      auto entryQuery = find<DboPlatformStatus>()
+          .where("(timestamp > ? OR (timestamp = ? AND id > ?)) AND timestamp <= ?")
+          .bind(cursor.lastTimestamp).bind(cursor.lastTimestamp).bind(cursor.lastId).bind(cursor.endDate);
+      if (! allViews) {
+        entryQuery.where("view_name = ?").bind(cursor.view);
+      }
+      if (cursor.resolution > 0) {
+        entryQuery.where(RAW_TAIL_CONDITION)
+            .bind(cursor.resolution).bind(rollupStart).bind(cursor.endDate).bind(cursor.resolution).bind(cursor.startDate);
+      }
+      const int maxRawEntries = maxEntries - count;
+      DboPlatformStatusCollectionT dbEntries = entryQuery.orderBy("timestamp, id").limit(maxRawEntries);
+      int rawCount = 0;
+      for (auto &entry : dbEntries) {
+        entries.push_back(entry->data());
+        cursor.lastTimestamp = entry->timestamp;
+        cursor.lastId = entry.id();
+        ++rawCount;
+      }
+      count += rawCount;
+      cursor.atEnd = (rawCount < maxRawEntries);
+    }
+  }
+  catch (const dbo::Exception &ex)
+  {
+    count = -1;
+    CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
+  }
+  transaction.commit();
+  return count;
+}
+
 int DbSession::getLastPlatformStatus(PlatformStatusT &platfotmStatus, const std::string &view)
 {
+  ensureStatusTables();
+
   int count = -1;
   dbo::Transaction transaction(*this);
   try
   {
-    DboPlatformStatusCollectionT queryResults;
-    if (view.empty()) {
-      queryResults = find<DboPlatformStatus>()
-          .orderBy("timestamp DESC")
-          .limit(1);
-    } else {
-      queryResults = find<DboPlatformStatus>()
-          .orderBy("timestamp DESC")
-          .limit(1);
+    auto currentQuery = query<CurrentStatusT>(CURRENT_STATUS_SQL);
+    if (! view.empty()) {
+      currentQuery.where("view_name = ?").bind(view);
     }
-
-    if (queryResults.size() == 1) {
+    dbo::collection<CurrentStatusT> queryResults = currentQuery.orderBy("timestamp DESC").limit(1);
+    for (const auto& entry: queryResults) {
+      platfotmStatus = currentStatusData(entry);
       count = 0;
-      platfotmStatus = queryResults.begin()->modify()->data();
     }
   }
   catch (const dbo::Exception &ex)
@@ -754,6 +1156,439 @@ int DbSession::getLastPlatformStatus(PlatformStatusT &platfotmStatus, const std:
   return count;
 }
 
+int DbSession::listLastPlatformStatuses(PlatformStatusMapT& statuses)
+{
+  ensureStatusTables();
+
+  int count = 0;
+  dbo::Transaction transaction(*this);
+  try
+  {
+    dbo::collection<CurrentStatusT> queryResults = query<CurrentStatusT>(CURRENT_STATUS_SQL);
+    statuses.clear();
+    for (const auto& entry: queryResults) {
+      auto data = currentStatusData(entry);
+      statuses.insert(data.view_name, data);
+      ++count;
+    }
+  }
+  catch (const dbo::Exception &ex)
+  {
+    count = -1;
+    CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
+  }
+  transaction.commit();
+  return count;
+}
+
+long DbSession::statusHistoryResolution(long startDate, long endDate)
+{
+  long resolution = 0;
+  for (auto tier: STATUS_ROLLUP_RESOLUTIONS) {
+    if ((endDate - startDate) / tier >= STATUS_HISTORY_MIN_POINTS) {
+      resolution = tier;
+    }
+  }
+  return resolution;
+}
+
+void DbSession::ensureStatusTables(void)
+{
+  if (m_statusTablesReady) {
+    return;
+  }
+
+  dbo::Transaction transaction(*this);
+  try
+  {
+    execute("CREATE TABLE IF NOT EXISTS qosdata_rollup ("
+            " tier integer NOT NULL,"
+            " view_name text NOT NULL REFERENCES \"view\" (\"name\") ON DELETE CASCADE,"
+            " timestamp bigint NOT NULL,"
+            " status integer NOT NULL,"
+            " sample_count integer NOT NULL,"
+            " normal real NOT NULL,"
+            " minor real NOT NULL,"
+            " major real NOT NULL,"
+            " critical real NOT NULL,"
+            " unknown real NOT NULL,"
+            " normal_duration bigint NOT NULL,"
+            " minor_duration bigint NOT NULL,"
+            " major_duration bigint NOT NULL,"
+            " critical_duration bigint NOT NULL,"
+            " unknown_duration bigint NOT NULL,"
+            " PRIMARY KEY (tier, view_name, timestamp))");
+    execute("CREATE INDEX IF NOT EXISTS qosdata_rollup_tier_timestamp ON qosdata_rollup (tier, timestamp)");
+    execute("CREATE INDEX IF NOT EXISTS qosdata_view_timestamp ON qosdata (view_name, timestamp)");
+    execute("CREATE INDEX IF NOT EXISTS qosdata_timestamp ON qosdata (timestamp)");
+    execute("CREATE INDEX IF NOT EXISTS notification_view_last_change ON notification (view_name, last_change)");
+    execute("CREATE INDEX IF NOT EXISTS notification_last_change ON notification (last_change)");
+    execute("CREATE INDEX IF NOT EXISTS user_view_user_name ON user_view (user_name)");
+    execute("CREATE TABLE IF NOT EXISTS qosdata_current ("
+            " view_name text NOT NULL PRIMARY KEY REFERENCES \"view\" (\"name\") ON DELETE CASCADE,"
+            " timestamp bigint NOT NULL,"
+            " status integer NOT NULL,"
+            " normal real NOT NULL,"
+            " minor real NOT NULL,"
+            " major real NOT NULL,"
+            " critical real NOT NULL,"
+            " unknown real NOT NULL)");
+    // seeds the current statuses of a database created before the table existed
+    execute("INSERT INTO qosdata_current (view_name, timestamp, status, normal, minor, major, critical, unknown)"
+            " SELECT q.view_name, q.timestamp, q.status, q.normal, q.minor, q.major, q.critical, q.unknown FROM qosdata q"
+            " WHERE NOT EXISTS (SELECT 1 FROM qosdata_current)"
+            "   AND q.timestamp = (SELECT MAX(timestamp) FROM qosdata WHERE view_name = q.view_name)"
+            " ON CONFLICT (view_name) DO NOTHING");
+    m_statusTablesReady = true;
+  }
+  catch (const dbo::Exception &ex)
+  {
+    CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
+  }
+  transaction.commit();
+}
+
+std::pair<int, QString> DbSession::updateStatusRollups(void)
+{
+  std::pair<int, QString> out{ngrt4n::RcSuccess, ""};
+  ensureStatusTables();
+
+  int count = 0;
+  for (const auto& view: listViews()) {
+    long sourceResolution = 0;
+    for (auto resolution: STATUS_ROLLUP_RESOLUTIONS) {
+      int rollupCount = rollupViewStatus(view.name, resolution, sourceResolution);
+      if (rollupCount < 0) {
+        out.first = ngrt4n::RcDbError;
+        out.second = QObject::tr("failed to update the status rollups of view %1").arg(view.name.c_str());
+        break;
+      }
+      count += rollupCount;
+      sourceResolution = resolution;
+    }
+  }
+  if (out.first == ngrt4n::RcSuccess) {
+    out.second = QObject::tr("%1 status rollup(s) updated").arg(count);
+  }
+
+  return out;
+}
+
+/**
+ * Rolls up the complete buckets of the given tier not yet computed, either from the raw samples (sourceResolution = 0)
+ * or from the rollups of the finer tier. Each sample holds until the next one, as in the SLA computation.
+ * Returns the number of rollups written, or -1 on error.
+ */
+int DbSession::rollupViewStatus(const std::string& view, long resolution, long sourceResolution)
+{
+  int count = 0;
+  dbo::Transaction transaction(*this);
+  try
+  {
+    std::string sourceTable = sourceResolution > 0 ? "qosdata_rollup" : "qosdata";
+    std::string sourceFilter = sourceResolution > 0 ? QString("tier = %1 AND view_name = ?").arg(sourceResolution).toStdString() : "view_name = ?";
+    long lastBucket = query<long>("SELECT COALESCE(MAX(timestamp), -1) FROM qosdata_rollup")
+        .where("tier = ? AND view_name = ?").bind(resolution).bind(view).resultValue();
+    long firstSource = query<long>("SELECT COALESCE(MIN(timestamp), -1) FROM " + sourceTable)
+        .where(sourceFilter).bind(view).resultValue();
+    long lastSource = query<long>("SELECT COALESCE(MAX(timestamp), -1) FROM " + sourceTable)
+        .where(sourceFilter).bind(view).resultValue();
+
+    // a bucket is complete once the source has data past its end
+    long sourceEnd = sourceResolution > 0 ? lastSource + sourceResolution : lastSource;
+    long from = lastBucket >= 0 ? lastBucket + resolution : firstSource - firstSource % resolution;
+    long to = std::min(sourceEnd - sourceEnd % resolution, from + STATUS_ROLLUP_CHUNK_BUCKETS * resolution);
+
+    if (firstSource >= 0 && to > from) {
+      StatusRollupsT rollups;
+      if (sourceResolution > 0) {
+        typedef std::tuple<long, long, float, float, float, float, float, long, long, long, long, long> SourceRollupT;
+        dbo::collection<SourceRollupT> sourceRollups =
+            query<SourceRollupT>("SELECT timestamp, sample_count, normal, minor, major, critical, unknown,"
+                                 " normal_duration, minor_duration, major_duration, critical_duration, unknown_duration"
+                                 " FROM qosdata_rollup")
+            .where(sourceFilter + " AND timestamp >= ? AND timestamp < ?").bind(view).bind(from).bind(to);
+        for (const auto& sourceRollup: sourceRollups) {
+          auto& rollup = rollups[std::get<0>(sourceRollup) - std::get<0>(sourceRollup) % resolution];
+          long sampleCount = std::get<1>(sourceRollup);
+          rollup.sampleCount += sampleCount;
+          rollup.ratios[ngrt4n::Normal] += static_cast<double>(std::get<2>(sourceRollup)) * sampleCount;
+          rollup.ratios[ngrt4n::Minor] += static_cast<double>(std::get<3>(sourceRollup)) * sampleCount;
+          rollup.ratios[ngrt4n::Major] += static_cast<double>(std::get<4>(sourceRollup)) * sampleCount;
+          rollup.ratios[ngrt4n::Critical] += static_cast<double>(std::get<5>(sourceRollup)) * sampleCount;
+          rollup.ratios[ngrt4n::Unknown] += static_cast<double>(std::get<6>(sourceRollup)) * sampleCount;
+          rollup.durations[ngrt4n::Normal] += std::get<7>(sourceRollup);
+          rollup.durations[ngrt4n::Minor] += std::get<8>(sourceRollup);
+          rollup.durations[ngrt4n::Major] += std::get<9>(sourceRollup);
+          rollup.durations[ngrt4n::Critical] += std::get<10>(sourceRollup);
+          rollup.durations[ngrt4n::Unknown] += std::get<11>(sourceRollup);
+        }
+      } else {
+        // the sample preceding the range holds until the first one of the range, the one following it closes the last interval
+        typedef std::tuple<long, int, float, float, float, float, float> SampleT;
+        const std::string sampleSql = "SELECT timestamp, status, normal, minor, major, critical, unknown FROM qosdata";
+        std::vector<SampleT> samples;
+        dbo::collection<SampleT> previousSample = query<SampleT>(sampleSql)
+            .where("view_name = ? AND timestamp < ?").bind(view).bind(from).orderBy("timestamp DESC").limit(1);
+        samples.insert(samples.end(), previousSample.begin(), previousSample.end());
+        dbo::collection<SampleT> rangeSamples = query<SampleT>(sampleSql)
+            .where("view_name = ? AND timestamp >= ? AND timestamp < ?").bind(view).bind(from).bind(to).orderBy("timestamp");
+        samples.insert(samples.end(), rangeSamples.begin(), rangeSamples.end());
+        dbo::collection<SampleT> nextSample = query<SampleT>(sampleSql)
+            .where("view_name = ? AND timestamp >= ?").bind(view).bind(to).orderBy("timestamp").limit(1);
+        samples.insert(samples.end(), nextSample.begin(), nextSample.end());
+
+        for (size_t index = 0; index < samples.size(); ++index) {
+          long timestamp = std::get<0>(samples[index]);
+          if (timestamp >= from && timestamp < to) {
+            auto& rollup = rollups[timestamp - timestamp % resolution];
+            ++rollup.sampleCount;
+            rollup.ratios[ngrt4n::Normal] += static_cast<double>(std::get<2>(samples[index]));
+            rollup.ratios[ngrt4n::Minor] += static_cast<double>(std::get<3>(samples[index]));
+            rollup.ratios[ngrt4n::Major] += static_cast<double>(std::get<4>(samples[index]));
+            rollup.ratios[ngrt4n::Critical] += static_cast<double>(std::get<5>(samples[index]));
+            rollup.ratios[ngrt4n::Unknown] += static_cast<double>(std::get<6>(samples[index]));
+          }
+          if (index + 1 < samples.size()) {
+            addStatusDuration(rollups, resolution, std::get<1>(samples[index]),
+                              std::max(timestamp, from), std::min(std::get<0>(samples[index + 1]), to));
+          }
+        }
+      }
+
+      execute("DELETE FROM qosdata_rollup WHERE tier = ? AND view_name = ? AND timestamp >= ? AND timestamp < ?")
+          .bind(resolution).bind(view).bind(from).bind(to);
+      for (auto rollup = rollups.cbegin(); rollup != rollups.cend(); ++rollup) {
+        const auto& data = rollup.value();
+        int status = ngrt4n::Normal; // the status that held the longest within the bucket
+        for (int severity = ngrt4n::Minor; severity <= ngrt4n::Unknown; ++severity) {
+          if (data.durations[severity] > data.durations[status]) {
+            status = severity;
+          }
+        }
+        double sampleCount = std::max(data.sampleCount, 1L);
+        execute("INSERT INTO qosdata_rollup (tier, view_name, timestamp, status, sample_count,"
+                " normal, minor, major, critical, unknown,"
+                " normal_duration, minor_duration, major_duration, critical_duration, unknown_duration)"
+                " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)")
+            .bind(resolution).bind(view).bind(rollup.key()).bind(status).bind(data.sampleCount)
+            .bind(data.ratios[ngrt4n::Normal] / sampleCount)
+            .bind(data.ratios[ngrt4n::Minor] / sampleCount)
+            .bind(data.ratios[ngrt4n::Major] / sampleCount)
+            .bind(data.ratios[ngrt4n::Critical] / sampleCount)
+            .bind(data.ratios[ngrt4n::Unknown] / sampleCount)
+            .bind(data.durations[ngrt4n::Normal])
+            .bind(data.durations[ngrt4n::Minor])
+            .bind(data.durations[ngrt4n::Major])
+            .bind(data.durations[ngrt4n::Critical])
+            .bind(data.durations[ngrt4n::Unknown]);
+        ++count;
+      }
+    }
+  }
+  catch (const dbo::Exception &ex)
+  {
+    count = -1;
+    REPORTD_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
+  }
+  transaction.commit();
+  return count;
+}
+
+/**
+ * Deletes the raw samples and rollups older than the retention set for their tier (resolution 0 for raw samples),
+ * tiers without retention are kept forever. Data are only deleted once rolled up into the next tier,
+ * and a purge deletes at most STATUS_PURGE_MAX_CHUNKS days per tier to keep transactions short.
+ */
+std::pair<int, QString> DbSession::purgeExpiredStatusData(const QMap<long, long>& retentions)
+{
+  std::pair<int, QString> out{ngrt4n::RcSuccess, ""};
+  ensureStatusTables();
+
+  std::vector<long> tiers = {0};
+  tiers.insert(tiers.end(), STATUS_ROLLUP_RESOLUTIONS.begin(), STATUS_ROLLUP_RESOLUTIONS.end());
+  for (size_t tierIndex = 0; tierIndex < tiers.size() && out.first == ngrt4n::RcSuccess; ++tierIndex) {
+    const long resolution = tiers[tierIndex];
+    const long retention = retentions.value(resolution, 0);
+    if (retention <= 0) {
+      continue;
+    }
+
+    std::string table = resolution > 0 ? "qosdata_rollup" : "qosdata";
+    std::string filter = resolution > 0 ? QString("tier = %1 AND ").arg(resolution).toStdString() : "";
+    if (tierIndex + 1 < tiers.size()) {
+      filter += QString("timestamp < COALESCE((SELECT MAX(r.timestamp) + %1 FROM qosdata_rollup r"
+                        " WHERE r.tier = %1 AND r.view_name = %2.view_name), 0) AND ")
+          .arg(QString::number(tiers[tierIndex + 1]), table.c_str()).toStdString();
+    }
+    const long cutoff = time(nullptr) - retention;
+    for (int chunk = 0; chunk < STATUS_PURGE_MAX_CHUNKS; ++chunk) {
+      dbo::Transaction transaction(*this);
+      try
+      {
+        long oldest = query<long>("SELECT COALESCE(MIN(timestamp), -1) FROM " + table)
+            .where(filter + "timestamp < ?").bind(cutoff).resultValue();
+        if (oldest < 0) {
+          transaction.commit();
+          break;
+        }
+        execute("DELETE FROM " + table + " WHERE " + filter + "timestamp < ?")
+            .bind(std::min(oldest + STATUS_PURGE_CHUNK, cutoff));
+      }
+      catch (const dbo::Exception &ex)
+      {
+        out.first = ngrt4n::RcDbError;
+        out.second = QObject::tr("failed to purge expired status data: %1").arg(ex.what());
+        REPORTD_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
+      }
+      transaction.commit();
+      if (out.first != ngrt4n::RcSuccess) {
+        break;
+      }
+    }
+  }
+
+  return out;
+}
+
+/**
+ * Computes the time spent by the views in each status over the range, in the database: the buckets
+ * of the rollup tier matching the range that lie entirely within it are summed, then the raw samples
+ * recorded before the first and after the last of these buckets of each view are walked with a window
+ * function, each sample holding until the next one or the start of the buckets.
+ * Returns the number of views with data, or -1 on error.
+ */
+int DbSession::listStatusDurations(StatusDurationMapT& durations, const std::string& view, long startDate, long endDate)
+{
+  ensureStatusTables();
+
+  int count = 0;
+  dbo::Transaction transaction(*this);
+  try
+  {
+    const bool allViews = view.empty() || view == "ALL";
+    const std::string viewFilter = allViews ? "" : " AND view_name = ?";
+    const long resolution = statusHistoryResolution(startDate, endDate);
+    // only whole buckets are summed, partly overlapping ones would count time outside the range
+    const long bucketStart = (resolution > 0 && startDate % resolution != 0) ? startDate - startDate % resolution + resolution : startDate;
+    const long lastBucketStart = endDate - resolution;
+
+    durations.clear();
+    if (resolution > 0) {
+      typedef std::tuple<std::string, long, long, long, long, long> RollupDurationsT;
+      auto rollupQuery = query<RollupDurationsT>("SELECT view_name, SUM(normal_duration), SUM(minor_duration), SUM(major_duration),"
+                                                 " SUM(critical_duration), SUM(unknown_duration)"
+                                                 " FROM qosdata_rollup"
+                                                 " WHERE tier = ? AND timestamp >= ? AND timestamp <= ?" + viewFilter +
+                                                 " GROUP BY view_name")
+          .bind(resolution).bind(bucketStart).bind(lastBucketStart);
+      if (! allViews) {
+        rollupQuery.bind(view);
+      }
+      dbo::collection<RollupDurationsT> rollupDurations = rollupQuery;
+      for (const auto& entry: rollupDurations) {
+        auto& viewDurations = durations[std::get<0>(entry)];
+        viewDurations.normal += std::get<1>(entry);
+        viewDurations.minor += std::get<2>(entry);
+        viewDurations.major += std::get<3>(entry);
+        viewDurations.critical += std::get<4>(entry);
+        viewDurations.unknown += std::get<5>(entry);
+      }
+    }
+
+    // the span covered by the summed buckets is resolved once per view; with no rollup tier, or no bucket
+    // for a view, it is null and all the raw samples of the range are walked
+    typedef std::tuple<std::string, int, long> RawDurationT;
+    auto rawQuery = query<RawDurationT>("SELECT view_name, status,"
+                                        "  SUM(CASE WHEN covered_start IS NOT NULL AND timestamp < covered_start AND next_timestamp > covered_start"
+                                        "    THEN covered_start ELSE next_timestamp END - timestamp) FROM ("
+                                        "  SELECT view_name, status, timestamp, covered_start,"
+                                        "    LEAD(timestamp) OVER (PARTITION BY view_name ORDER BY timestamp) AS next_timestamp"
+                                        "  FROM ("
+                                        "    SELECT q.view_name AS view_name, q.status AS status, q.timestamp AS timestamp,"
+                                        "      c.covered_start AS covered_start, c.covered_end AS covered_end"
+                                        "    FROM qosdata q LEFT JOIN ("
+                                        "      SELECT view_name, MIN(timestamp) AS covered_start, MAX(timestamp) + ? AS covered_end FROM qosdata_rollup"
+                                        "      WHERE tier = ? AND timestamp >= ? AND timestamp <= ? GROUP BY view_name"
+                                        "    ) c ON c.view_name = q.view_name"
+                                        "    WHERE q.timestamp >= ? AND q.timestamp <= ?" + (allViews ? std::string() : std::string(" AND q.view_name = ?")) +
+                                        "  ) edges"
+                                        "  WHERE covered_start IS NULL OR timestamp < covered_start OR timestamp >= covered_end"
+                                        ") samples"
+                                        " WHERE next_timestamp IS NOT NULL"
+                                        " GROUP BY view_name, status")
+        .bind(resolution).bind(resolution).bind(bucketStart).bind(lastBucketStart)
+        .bind(startDate).bind(endDate);
+    if (! allViews) {
+      rawQuery.bind(view);
+    }
+    dbo::collection<RawDurationT> rawDurations = rawQuery;
+    for (const auto& entry: rawDurations) {
+      durations[std::get<0>(entry)].add(std::get<1>(entry), std::get<2>(entry));
+    }
+    count = durations.size();
+  }
+  catch (const dbo::Exception &ex)
+  {
+    count = -1;
+    CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
+  }
+  transaction.commit();
+  return count;
+}
+
+/**
+ * Lists the rollups of the given tier overlapping the range, followed for each view by the raw samples
+ * recorded after its last complete bucket.
+ */
+int DbSession::listStatusRollups(PlatformMappedStatusHistoryT& statusHistory, const std::string& view, long resolution, long startDate, long endDate)
+{
+  ensureStatusTables();
+
+  int count = 0;
+  dbo::Transaction transaction(*this);
+  try
+  {
+    const bool allViews = view.empty() || view == "ALL";
+    const long rollupStart = startDate - startDate % resolution;
+    auto rollupQuery = query<RollupStatusT>(ROLLUP_STATUS_SQL)
+        .where("tier = ? AND timestamp >= ? AND timestamp <= ?")
+        .bind(resolution).bind(rollupStart).bind(endDate);
+    if (! allViews) {
+      rollupQuery.where("view_name = ?").bind(view);
+    }
+    dbo::collection<RollupStatusT> rollups = rollupQuery.orderBy("view_name, timestamp");
+
+    statusHistory.clear();
+    for (const auto& rollup: rollups) {
+      auto data = rollupStatusData(rollup, resolution);
+      statusHistory[data.view_name].push_back(data);
+      ++count;
+    }
+
+    // the raw boundary is resolved per view, so a view lagging in its rollups does not pull the samples of the others
+    auto rawQuery = find<DboPlatformStatus>()
+        .where("timestamp >= ? AND timestamp <= ?").bind(startDate).bind(endDate)
+        .where(RAW_TAIL_CONDITION).bind(resolution).bind(rollupStart).bind(endDate).bind(resolution).bind(startDate);
+    if (! allViews) {
+      rawQuery.where("view_name = ?").bind(view);
+    }
+    DboPlatformStatusCollectionT dbEntries = rawQuery.orderBy("timestamp");
+    for (auto &entry : dbEntries) {
+      auto data = entry->data();
+      statusHistory[data.view_name].push_back(data);
+      ++count;
+    }
+  }
+  catch (const dbo::Exception &ex)
+  {
+    count = -1;
+    CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
+  }
+  transaction.commit();
+  return count;
+}
+
 int DbSession::addNotification(const std::string &viewId, int viewStatus)
 {
   int retValue = ngrt4n::RcDbError;
@@ -888,10 +1723,11 @@ void DbSession::getLastNotificationInfo(NotificationT &lastNotifInfo, const std:
 }
 
 std::pair<int, QString>
-DbSession::listViewRelatedNotifications(NotificationMapT &notifications, const std::string &userId)
+DbSession::listViewRelatedNotifications(NotificationMapT &notifications, const std::string &userId, long sinceLastChange)
 {
   std::pair<int, QString> out{ngrt4n::RcDbError, ""};
 
+  ensureStatusTables();
   dbo::Transaction transaction(*this);
   try
   {
@@ -902,39 +1738,41 @@ DbSession::listViewRelatedNotifications(NotificationMapT &notifications, const s
     }
     else
     {
-      DboNotificationCollectionT dboNotifications;
-      notifications.clear();
-      if (dboUser->role == DboUser::AdmRole)
-      {
-        dboNotifications = find<DboNotification>().orderBy("last_change");
-        for (const auto &entry : dboNotifications)
-        {
-          NotificationT data = entry->data();
-          notifications.insert(data.view_name, data);
-        }
+      // the boundary second is included since entries may have been added after the previous call within that second;
+      // without a previous call only the last entry of each view is read
+      typedef std::tuple<std::string, int, int, long, std::string> NotificationEntryT;
+      std::string sql = "SELECT n.view_name, n.view_status, n.ack_status, n.last_change, COALESCE(n.ack_user_name, '')"
+                        " FROM notification n";
+      bool isAdmin = dboUser->role == DboUser::AdmRole;
+      if (! isAdmin) {
+        sql += " JOIN user_view uv ON uv.view_name = n.view_name AND uv.user_name = ?";
       }
-      else
-      {
-        std::string sql = QString("SELECT n.view_name, view_status, ack_status, last_change, ack_user_name"
-                                  " FROM notification n, user_view uv"
-                                  " WHERE uv.user_name = '%1'"
-                                  "   AND n.view_name = uv.view_name"
-                                  " ORDER BY last_change")
-            .arg(userId.c_str())
-            .toStdString();
-
-        dbo::collection<std::tuple<std::string, int, int, int, std::string>>
-            results = query<std::tuple<std::string, int, int, int, std::string>>(sql);
-
-        for (const auto &entry : results) {
-          NotificationT data;
-          data.view_name = std::get<0>(entry);
-          data.view_status = std::get<1>(entry);
-          data.ack_status = std::get<2>(entry);
-          data.last_change = std::get<3>(entry);
-          data.ack_username = std::get<4>(entry);
-          notifications.insert(data.view_name, data);
-        }
+      sql += " WHERE n.view_name IS NOT NULL";
+      if (sinceLastChange > 0) {
+        sql += " AND n.last_change >= ?";
+      } else {
+        sql += " AND n.last_change = (SELECT MAX(last_change) FROM notification WHERE view_name = n.view_name)";
+      }
+      sql += " ORDER BY n.last_change, n.id";
+
+      auto notificationQuery = query<NotificationEntryT>(sql);
+      if (! isAdmin) {
+        notificationQuery.bind(userId);
+      }
+      if (sinceLastChange > 0) {
+        notificationQuery.bind(sinceLastChange);
+      }
+      dbo::collection<NotificationEntryT> results = notificationQuery;
+
+      notifications.clear();
+      for (const auto &entry : results) {
+        NotificationT data;
+        data.view_name = std::get<0>(entry);
+        data.view_status = std::get<1>(entry);
+        data.ack_status = std::get<2>(entry);
+        data.last_change = std::get<3>(entry);
+        data.ack_username = std::get<4>(entry);
+        notifications.insert(data.view_name, data);
       }
       out.first = ngrt4n::RcSuccess;
     }
@@ -979,6 +1817,7 @@ DbSession::addSource(const SourceT &sinfo)
     CORE_LOG("error", QObject::tr("error at %1 adding source in database (%2").arg(Q_FUNC_INFO, ex.what()).toStdString());
   }
   transaction.commit();
+  publishChange(CachedSources);
 
   return out;
 }
@@ -1012,6 +1851,7 @@ DbSession::updateSource(const SourceT &sinfo)
   }
 
   transaction.commit();
+  publishChange(CachedSources);
 
   return out;
 }
@@ -1037,28 +1877,45 @@ DbSession::deleteSource(const QString &sid)
     CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
   }
   transaction.commit();
+  publishChange(CachedSources);
 
   return out;
 }
 
 SourceListT DbSession::listSources(int monType)
 {
+  if (! isCached(CachedSources)) {
+    loadSources();
+  }
+  if (monType == MonitorT::Any) {
+    return m_sourcesCache;
+  }
+
   SourceListT sources;
+  for (const auto &sinfo : m_sourcesCache)
+  {
+    if (sinfo.mon_type == monType)
+    {
+      sources.insert(sinfo.id, sinfo);
+    }
+  }
+  return sources;
+}
+
+void DbSession::loadSources(void)
+{
+  quint64 generation = reloadCachedData(CachedSources);
+  m_sourcesCache.clear();
   dbo::Transaction transaction(*this);
   try
   {
     DboSourceCollectionT dboSources = find<DboSource>();
     for (const auto &dboSrc : dboSources)
     {
-
       if (!dboSrc.get())
       {
         continue;
       }
-      if (dboSrc->mon_type != monType && monType != MonitorT::Any)
-      {
-        continue;
-      }
 
       SourceT sinfo;
       sinfo.id = QString::fromStdString(dboSrc->id);
@@ -1070,17 +1927,16 @@ SourceListT DbSession::listSources(int monType)
       sinfo.icon = QString::fromStdString(dboSrc->id);
       sinfo.verify_ssl_peer = static_cast<qint8>(dboSrc->verify_ssl_peer);
 
-      sources.insert(sinfo.id, sinfo);
+      m_sourcesCache.insert(sinfo.id, sinfo);
     }
+    m_cacheGenerations[CachedSources] = generation;
   }
   catch (const dbo::Exception &ex)
   {
-    sources.clear();
+    m_sourcesCache.clear();
     CORE_LOG("error", QObject::tr("%1: %2").arg(Q_FUNC_INFO, ex.what()).toStdString());
   }
   transaction.commit();
-
-  return sources;
 }
 
 std::pair<bool, SourceT>
@@ -25,7 +25,10 @@
 #ifndef DBSESSION_HPP
 #define DBSESSION_HPP
 
+#include <atomic>
 #include <climits>
+#include <map>
+#include <vector>
 #include <semaphore.h>
 #include "dbo/src/DbObjects.hpp"
 #include <Wt/Auth/AuthService.h>
@@ -41,6 +44,8 @@
 #include <Wt/Auth/Login.h>
 #include <Wt/Auth/HashFunction.h>
 
+class DbConnectionPool;
+
 typedef Wt::Auth::Dbo::AuthInfo<DboUser> AuthInfo;
 typedef Wt::Auth::Dbo::UserDatabase<AuthInfo> UserDatabase;
 
@@ -57,10 +62,29 @@ enum {
 class DbSession : public dbo::Session
 {
 public:
+  static const std::vector<long> STATUS_ROLLUP_RESOLUTIONS; // rollup tiers in seconds, from the finest
+  static long statusHistoryResolution(long startDate, long endDate);
+
+  enum CachedDataT {
+    CachedUsers = 0,
+    CachedViews,
+    CachedSources,
+    CachedViewAssignments,
+    CachedDataCount
+  };
+  static const std::vector<std::string> CACHED_DATA_NAMES; // names under which changes are published, by cached data
+  static const std::string CHANGE_CHANNEL; // PostgreSQL channel on which changes are notified
+  static const std::string CHANGE_ORIGIN; // identifies the changes notified by this process
+  static void invalidateCachedData(int cachedData); // marks the data stale in all the sessions of the process
+  static quint64 cachedDataGeneration(int cachedData) { return cacheGeneration(cachedData).load(); } // bumped on each invalidation
+  static int takeOwnChanges(int cachedData, quint64 fromVersion, quint64 toVersion); // versions in ]from, to] written by this process
+
   DbSession();
   ~DbSession();
 
   bool isReady() const {return m_dbIsReady;}
+  int dbType(void) const {return m_dbType;}
+  DbConnectionPool* connectionPool(void) const {return m_connectionPool;}
 
   void setupDbMapping(void);
   int initDb(void);
@@ -76,7 +100,6 @@ public:
     return m_passAuthService;
   }
   Wt::Auth::Login& wtAuthLogin(void) {
-    rereadAll();
     return m_wtAuthLogin;
   }
   bool isLogged(void) {
@@ -123,12 +146,18 @@ public:
   int addPlatformStatus(const PlatformStatusT& platformStatus);
   std::pair<int, QString>  addPlatformStatusList(const ListofPlatformStatusT& platformStatusList);
   int listStatusHistory(PlatformMappedStatusHistoryT& statusHistory, const std::string& view, long startDate = 0, long endDate = LONG_MAX);
+  int fetchStatusHistory(StatusHistoryCursorT& cursor, ListofPlatformStatusT& entries, int maxEntries);
   int getLastPlatformStatus(PlatformStatusT& platformStatus, const std::string& view);
+  int listLastPlatformStatuses(PlatformStatusMapT& statuses);
+  int listStatusDurations(StatusDurationMapT& durations, const std::string& view, long startDate, long endDate);
+  std::pair<int, QString> updateStatusRollups(void);
+  std::pair<int, QString> purgeExpiredStatusData(const QMap<long, long>& retentions);
 
   DbViewsT listViews(void);
   DbViewsT listAssignedViewsByUser(const std::string& uname);
   UserViewsT updateUserViewList(void);
   bool findView(const std::string& vname, DboView& view);
+  int listChangeVersions(QMap<int, quint64>& versions);
 
   int addSession(const DboLoginSession& session);
   int checkUserCookie(const DboLoginSession& session);
@@ -137,7 +166,7 @@ public:
   int updateNotificationAckStatusForUser(const std::string& userId, const std::string& viewId, int newAckStatus);
   int updateNotificationAckStatusForView(const std::string& userId, const std::string& viewId, int newAckStatus);
   void getLastNotificationInfo(NotificationT& lastNotifInfo, const std::string& viewId);
-  std::pair<int, QString> listViewRelatedNotifications(NotificationMapT& notifications, const std::string& userId);
+  std::pair<int, QString> listViewRelatedNotifications(NotificationMapT& notifications, const std::string& userId, long sinceLastChange = 0);
 
   std::pair<int, QString> addSource(const SourceT& sinfo);
   std::pair<int, QString> updateSource(const SourceT& sinfo);
@@ -147,12 +176,35 @@ public:
 
 private:
   bool m_dbIsReady;
+  bool m_statusTablesReady;
+  bool m_changeTableReady;
+  int m_dbType;
+  quint64 m_cacheGenerations[CachedDataCount]; // generation each cached data was loaded at, 0 if not loaded
+  DbUsersT m_usersCache;
+  DbViewsT m_viewsCache;
+  SourceListT m_sourcesCache;
+  UserViewsT m_userViewsCache;
+  std::map<std::string, DbViewsT> m_assignedViewsCache;
+  DbConnectionPool* m_connectionPool;
   UserDatabase* m_usersDb;
   DboUser m_loggedUser;
   Wt::Auth::Login m_wtAuthLogin;
   Wt::Auth::AuthService m_basicAuthService;
   Wt::Auth::PasswordService* m_passAuthService;
 
+  static std::atomic<quint64>& cacheGeneration(int cachedData);
+  static void recordOwnChange(int cachedData, quint64 version);
+  bool isCached(int cachedData) const {
+    return m_cacheGenerations[cachedData] == cacheGeneration(cachedData).load();
+  }
+  quint64 reloadCachedData(int cachedData);
+  void loadViewAssignments(void);
+  void loadSources(void);
+  void publishChange(int cachedData);
+  void ensureChangeTable(void);
+  void ensureStatusTables(void);
+  int rollupViewStatus(const std::string& view, long resolution, long sourceResolution);
+  int listStatusRollups(PlatformMappedStatusHistoryT& statusHistory, const std::string& view, long resolution, long startDate, long endDate);
   std::string hashPassword(const std::string& pass) {
     Wt::Auth::BCryptHashFunction h;
     return h.compute(pass, "$ngrt4n$salt");
@@ -0,0 +1,175 @@
+/*
+ * DbWriteQueue.cpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#include "DbWriteQueue.hpp"
+#include "DbSession.hpp"
+#include "WebUtils.hpp"
+#include <algorithm>
+#include <chrono>
+
+
+DbWriteQueue::DbWriteQueue(int capacity)
+  : m_capacity(std::max(1, capacity)),
+    m_stopped(true)
+{
+}
+
+
+DbWriteQueue::~DbWriteQueue()
+{
+  stop();
+}
+
+
+void DbWriteQueue::start(void)
+{
+  QMutexLocker locker(&m_mutex);
+  if (m_writer.joinable()) {
+    return;
+  }
+  m_stopped = false;
+  m_writer = std::thread(&DbWriteQueue::run, this);
+}
+
+
+void DbWriteQueue::stop(void)
+{
+  {
+    QMutexLocker locker(&m_mutex);
+    m_stopped = true;
+    m_notEmpty.wakeAll();
+    m_notFull.wakeAll();
+  }
+  if (m_writer.joinable()) {
+    m_writer.join();
+  }
+}
+
+
+void DbWriteQueue::addPlatformStatusList(const ListofPlatformStatusT& platformStatusList)
+{
+  for (const auto& platformStatus: platformStatusList) {
+    WriteT write;
+    write.type = PlatformStatusWrite;
+    write.platformStatus = platformStatus;
+    enqueue(std::move(write));
+  }
+}
+
+
+void DbWriteQueue::addNotification(const std::string& viewId, int viewStatus)
+{
+  WriteT write;
+  write.type = NotificationWrite;
+  write.viewId = viewId;
+  write.status = viewStatus;
+  enqueue(std::move(write));
+}
+
+
+void DbWriteQueue::updateNotificationAckStatusForUser(const std::string& userId, const std::string& viewId, int newAckStatus)
+{
+  WriteT write;
+  write.type = NotificationAckWrite;
+  write.userId = userId;
+  write.viewId = viewId;
+  write.status = newAckStatus;
+  enqueue(std::move(write));
+}
+
+
+DbWriteQueue::StatsT DbWriteQueue::stats(void) const
+{
+  QMutexLocker locker(&m_mutex);
+  StatsT stats = m_stats;
+  stats.depth = static_cast<int>(m_writes.size());
+  return stats;
+}
+
+
+void DbWriteQueue::enqueue(WriteT&& write)
+{
+  QMutexLocker locker(&m_mutex);
+  if (static_cast<int>(m_writes.size()) >= m_capacity && ! m_stopped) {
+    auto waitStartTime = std::chrono::steady_clock::now();
+    while (static_cast<int>(m_writes.size()) >= m_capacity && ! m_stopped) {
+      m_notFull.wait(&m_mutex);
+    }
+    m_stats.blockedSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - waitStartTime).count();
+  }
+  m_writes.push_back(std::move(write));
+  m_stats.peakDepth = std::max(m_stats.peakDepth, static_cast<int>(m_writes.size()));
+  m_notEmpty.wakeOne();
+}
+
+
+void DbWriteQueue::run(void)
+{
+  DbSession dbSession; // Wt::Dbo sessions must not be shared between threads
+  while (1) {
+    std::deque<WriteT> writes;
+    {
+      QMutexLocker locker(&m_mutex);
+      while (m_writes.empty() && ! m_stopped) {
+        m_notEmpty.wait(&m_mutex);
+      }
+      if (m_writes.empty()) {
+        break; // stopped, and everything written
+      }
+      writes.swap(m_writes);
+      m_notFull.wakeAll();
+    }
+
+    auto flushStartTime = std::chrono::steady_clock::now();
+    // statuses are written at once in a single transaction, notifications in their queuing order
+    ListofPlatformStatusT platformStatusList;
+    for (const auto& write: writes) {
+      if (write.type == PlatformStatusWrite) {
+        platformStatusList.push_back(write.platformStatus);
+      }
+    }
+    if (! platformStatusList.empty()) {
+      auto writeOut = dbSession.addPlatformStatusList(platformStatusList);
+      if (writeOut.first != ngrt4n::RcSuccess) {
+        REPORTD_LOG("error", writeOut.second);
+      }
+    }
+    for (const auto& write: writes) {
+      switch (write.type) {
+        case NotificationWrite:
+          dbSession.addNotification(write.viewId, write.status);
+          break;
+        case NotificationAckWrite:
+          dbSession.updateNotificationAckStatusForUser(write.userId, write.viewId, write.status);
+          break;
+        default:
+          break;
+      }
+    }
+
+    QMutexLocker locker(&m_mutex);
+    ++m_stats.flushes;
+    m_stats.lastFlushSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - flushStartTime).count();
+  }
+}
@@ -0,0 +1,90 @@
+/*
+ * DbWriteQueue.hpp
+# ------------------------------------------------------------------------ #
+# Copyright (c) 2010-2020 Rodrigue Chakode (rodrigue.chakode@gmail.com)    #
+# Creation Date: October 2026                                              #
+#                                                                          #
+# This file is part of RealOpInsight (http://RealOpInsight.com) authored   #
+# by Rodrigue Chakode <rodrigue.chakode@gmail.com>                         #
+#                                                                          #
+# RealOpInsight is free software: you can redistribute it and/or modify    #
+# it under the terms of the GNU General Public License as published by     #
+# the Free Software Foundation, either version 3 of the License, or        #
+# (at your option) any later version.                                      #
+#                                                                          #
+# The Software is distributed in the hope that it will be useful,          #
+# but WITHOUT ANY WARRANTY; without even the implied warranty of           #
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the            #
+# GNU General Public License for more details.                             #
+#                                                                          #
+# You should have received a copy of the GNU General Public License        #
+# along with RealOpInsight.  If not, see <http://www.gnu.org/licenses/>.   #
+#--------------------------------------------------------------------------#
+ */
+
+#ifndef DBWRITEQUEUE_HPP
+#define DBWRITEQUEUE_HPP
+
+#include "dbo/src/DbObjects.hpp"
+#include <QMutex>
+#include <QWaitCondition>
+#include <deque>
+#include <string>
+#include <thread>
+
+
+/**
+ * @brief Bounded write-behind queue for the platform statuses and notifications written by reportd.
+ * Writes are applied in batches by a dedicated thread with its own database session; producers
+ * block while the queue is full. Pending writes are flushed by stop().
+ */
+class DbWriteQueue
+{
+public:
+  struct StatsT {
+    int depth = 0;
+    int peakDepth = 0;
+    quint64 flushes = 0;
+    double lastFlushSeconds = 0;
+    double blockedSeconds = 0; // cumulated time producers waited for room in the queue
+  };
+
+  explicit DbWriteQueue(int capacity);
+  ~DbWriteQueue();
+
+  void start(void);
+  void stop(void);
+  void addPlatformStatusList(const ListofPlatformStatusT& platformStatusList);
+  void addNotification(const std::string& viewId, int viewStatus);
+  void updateNotificationAckStatusForUser(const std::string& userId, const std::string& viewId, int newAckStatus);
+  StatsT stats(void) const;
+
+private:
+  enum WriteTypeT {
+    PlatformStatusWrite,
+    NotificationWrite,
+    NotificationAckWrite
+  };
+
+  struct WriteT {
+    WriteTypeT type;
+    PlatformStatusT platformStatus;
+    std::string userId;
+    std::string viewId;
+    int status = 0;
+  };
+
+  int m_capacity;
+  bool m_stopped;
+  std::thread m_writer;
+  mutable QMutex m_mutex;
+  QWaitCondition m_notEmpty;
+  QWaitCondition m_notFull;
+  std::deque<WriteT> m_writes;
+  StatsT m_stats;
+
+  void enqueue(WriteT&& write);
+  void run(void);
+};
+
+#endif // DBWRITEQUEUE_HPP
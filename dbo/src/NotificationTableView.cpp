@@ -24,6 +24,7 @@
 
 #include "NotificationTableView.hpp"
 #include "WebUtils.hpp"
+#include <algorithm>
 
 namespace
 {
@@ -32,7 +33,8 @@ const int COLUMN_COUNT = 6;
 NotificationTableView::NotificationTableView(DbSession *dbSession, Wt::WContainerWidget *parent)
     : Wt::WTableView(),
       m_model(std::make_shared<Wt::WStandardItemModel>(0, COLUMN_COUNT)),
-      m_dbSession(dbSession)
+      m_dbSession(dbSession),
+      m_lastChange(0)
 {
   setSortingEnabled(true);
   setLayoutSizeAware(true);
@@ -66,22 +68,28 @@ void NotificationTableView::setModelHeader(void)
 int NotificationTableView::update(void)
 {
   setDisabled(true);
-  NotificationMapT notifications;
+  NotificationMapT changes;
 
-  auto listViewNotifs = m_dbSession->listViewRelatedNotifications(notifications, m_dbSession->loggedUser().username);
+  // only the notifications changed since the last update are fetched
+  auto listViewNotifs = m_dbSession->listViewRelatedNotifications(changes, m_dbSession->loggedUser().username, m_lastChange);
   if (listViewNotifs.first != ngrt4n::RcSuccess)
   {
     setDisabled(false);
     return listViewNotifs.first;
   }
+  for (const auto &change : changes)
+  {
+    m_notifications[change.view_name] = change;
+    m_lastChange = std::max(m_lastChange, change.last_change);
+  }
 
   m_model->clear();
   setModelHeader();
   for (const auto &service : m_services)
   {
-    NotificationMapT::Iterator notificationIter = notifications.find(service.name.toStdString());
-    bool found = (notificationIter != notifications.end());
-    if (notificationIter != notifications.end())
+    NotificationMapT::ConstIterator notificationIter = m_notifications.constFind(service.name.toStdString());
+    bool found = (notificationIter != m_notifications.cend());
+    if (found)
     {
       addServiceEntry(service, found, *notificationIter);
     }
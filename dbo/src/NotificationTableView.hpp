@@ -47,6 +47,8 @@ private:
   std::shared_ptr<Wt::WStandardItemModel> m_model;
   DbSession* m_dbSession;
   NodeListT m_services;
+  NotificationMapT m_notifications; // last notification of each view, updated incrementally
+  long m_lastChange;
 
   void addEvent(void);
   void setModelHeader(void);
@@ -23,7 +23,8 @@
 WT_ROOT = $$(WT_ROOT)
 QT	+= core xml network
 
-CONFIG += no_keywords
+CONFIG += no_keywords link_pkgconfig
+PKGCONFIG += libpq
 TEMPLATE = app
 RESOURCES += realopinsight.qrc
 
@@ -413,6 +414,14 @@ HEADERS += \
     core/src/StatusAggregator.hpp \
     core/src/BaseSettings.hpp \
     core/src/SettingFactory.hpp \
+    core/src/PollingScheduler.hpp \
+    core/src/SourceCircuitBreaker.hpp \
+    core/src/GraphLayout.hpp \
+    core/src/LayoutCache.hpp \
+    core/src/CompiledView.hpp \
+    core/src/ViewDependencyGraph.hpp \
+    core/src/CheckRegistry.hpp \
+    core/src/StatusJournal.hpp \
     web/src/utils/wtwithqt/DispatchThread.h \
     web/src/utils/smtpclient/qxtglobal.h \
     web/src/utils/smtpclient/qxtsmtp.h \
@@ -424,6 +433,9 @@ HEADERS += \
     web/src/utils/smtpclient/MailSender.hpp \
     web/src/utils/Logger.hpp \
     dbo/src/DbSession.hpp \
+    dbo/src/DbConnectionPool.hpp \
+    dbo/src/DbChangeListener.hpp \
+    dbo/src/DbWriteQueue.hpp \
     dbo/src/DbObjects.hpp \
     dbo/src/UserManagement.hpp \
     dbo/src/LdapUserManager.hpp \
@@ -457,7 +469,6 @@ HEADERS += \
     web/src/WebPlatformStatusDateFilter.hpp \
     web/src/WebPlatformStatusRaw.hpp \
     web/src/PlatformStatusCollector.hpp \
-    web/src/WebPlatformStatusAnalyticsData.hpp \
     web/src/WebPlatformStatusAnalyticsCharts.hpp
 
 SOURCES +=  core/src/Base.cpp \
@@ -472,9 +483,20 @@ SOURCES +=  core/src/Base.cpp \
     core/src/StatusAggregator.cpp \
     core/src/BaseSettings.cpp \
     core/src/SettingFactory.cpp \
+    core/src/PollingScheduler.cpp \
+    core/src/SourceCircuitBreaker.cpp \
+    core/src/GraphLayout.cpp \
+    core/src/LayoutCache.cpp \
+    core/src/CompiledView.cpp \
+    core/src/ViewDependencyGraph.cpp \
+    core/src/CheckRegistry.cpp \
+    core/src/StatusJournal.cpp \
     dbo/src/LdapUserManager.cpp \
     dbo/src/NotificationTableView.cpp \
     dbo/src/DbSession.cpp \
+    dbo/src/DbConnectionPool.cpp \
+    dbo/src/DbChangeListener.cpp \
+    dbo/src/DbWriteQueue.cpp \
     dbo/src/UserManagement.cpp \
     web/src/utils/wtwithqt/DispatchThread.C \
     web/src/utils/wtwithqt/WQApplication.C \
@@ -510,7 +532,6 @@ SOURCES +=  core/src/Base.cpp \
     web/src/WebInputList.cpp \
     web/src/WebPlatformStatusDateFilter.cpp \
     web/src/PlatformStatusCollector.cpp \
-    web/src/WebPlatformStatusAnalyticsData.cpp \
     web/src/WebPlatformStatusAnalyticsCharts.cpp \
     web/src/WebPlatformStatusRaw.cpp
 
@@ -540,7 +561,7 @@ reportd {
 server {
   SOURCES += web/src/realopinsight-server.cpp
   TARGET = realopinsight-server
-  LIBS += -lwthttp
+  LIBS += -lwthttp -lprometheus-cpp-core -lprometheus-cpp-pull
 }
 
 setupdb {
@@ -551,21 +572,20 @@ setupdb {
 unittests-web {
   QT += testlib
   TARGET = unittests-web
-  HEADERS += web/src/web_foundation_unittests.hpp \
-    web/src/web_foundation_unittests.hpp
+  HEADERS += web/src/web_foundation_unittests.hpp
   SOURCES += web/src/web_foundation_unittests.cpp
-    web/src/web_foundation_unittests.cpp \
+  LIBS += -lwttest
 }
 
 unittests-core {
   QT += testlib
   TARGET = unittests-core
   HEADERS += core/src/TestK8sHelper.hpp \
-    core/src/TestK8sHelper.hpp \
+    core/src/TestGraphLayout.hpp \
+    core/src/TestStatusJournal.hpp
   SOURCES += core/src/TestK8sHelper.cpp \
-    unittests/tst_mklshelpertest.cpp \
-    unittests/web_foundation_unittest.cpp \
-    core/src/TestK8sHelper.cpp \
+    core/src/TestGraphLayout.cpp \
+    core/src/TestStatusJournal.cpp \
     core/src/unittests.cpp
 }
 
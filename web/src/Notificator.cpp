@@ -41,7 +41,10 @@ namespace {
 }
 
 
-Notificator::Notificator(void)
+Notificator::Notificator(DbSession* dbSession, DbWriteQueue* writeQueue, QHash<QString, int>* lastNotifiedStatuses)
+  : m_dbSession(dbSession),
+    m_writeQueue(writeQueue),
+    m_lastNotifiedStatuses(lastNotifiedStatuses)
 {
   m_mailSender.reset(new MailSender(QString::fromStdString(m_preferences.getSmtpServerAddr()),
                                     m_preferences.getSmtpServerPort(),
@@ -94,14 +97,18 @@ void Notificator::handleNotification(const NodeT& node, const PlatformStatusT& q
 {
   std::string viewName = node.name.toStdString();
   QStringList recipients;
-  DbSession dbSession;
-  if (dbSession.listAssignedUsersEmails(recipients, viewName) <= 0) {
+  if (m_dbSession->listAssignedUsersEmails(recipients, viewName) <= 0) {
     REPORTD_LOG("info", QString("No notification recipients for view %1").arg(viewName.c_str()));
     return;
   }
 
+  // the database lags behind the write queue, so the statuses already notified by this process take precedence
   NotificationT lastNotifData;
-  dbSession.getLastNotificationInfo(lastNotifData, viewName);
+  if (m_lastNotifiedStatuses && m_lastNotifiedStatuses->contains(node.name)) {
+    lastNotifData.view_status = m_lastNotifiedStatuses->value(node.name);
+  } else {
+    m_dbSession->getLastNotificationInfo(lastNotifData, viewName);
+  }
   bool updateRequired = false;
   switch (node.sev) {
     case  ngrt4n::Normal:
@@ -120,8 +127,16 @@ void Notificator::handleNotification(const NodeT& node, const PlatformStatusT& q
   
  if (updateRequired) {
    sendEmailNotification(node, lastNotifData.view_status, qosData, recipients);
-   dbSession.updateNotificationAckStatusForUser("admin", viewName, DboNotification::Closed);
-   dbSession.addNotification(viewName, node.sev);
+   if (m_writeQueue) {
+     m_writeQueue->updateNotificationAckStatusForUser("admin", viewName, DboNotification::Closed);
+     m_writeQueue->addNotification(viewName, node.sev);
+   } else {
+     m_dbSession->updateNotificationAckStatusForUser("admin", viewName, DboNotification::Closed);
+     m_dbSession->addNotification(viewName, node.sev);
+   }
+   if (m_lastNotifiedStatuses) {
+     m_lastNotifiedStatuses->insert(node.name, node.sev);
+   }
  }
 }
 
@@ -27,7 +27,9 @@
 #include "Base.hpp"
 #include <QObject>
 #include <QString>
+#include <QHash>
 #include "dbo/src/DbSession.hpp"
+#include "dbo/src/DbWriteQueue.hpp"
 #include "WebNotificationSettings.hpp"
 #include "utils/smtpclient/MailSender.hpp"
 
@@ -36,12 +38,15 @@ class Notificator : public QObject
   Q_OBJECT
 
 public:
-  Notificator(void);
+  Notificator(DbSession* dbSession, DbWriteQueue* writeQueue = nullptr, QHash<QString, int>* lastNotifiedStatuses = nullptr);
   void sendEmailNotification(const NodeT& node, int lastState, const PlatformStatusT& pfStatus, const QStringList& recipients);
   void handleNotification(const NodeT& node, const PlatformStatusT& pfStatus);
 
 
 private:
+  DbSession* m_dbSession;
+  DbWriteQueue* m_writeQueue; // when set, notification updates are written behind
+  QHash<QString, int>* m_lastNotifiedStatuses; // last status notified per view, ahead of the queued writes
   std::unique_ptr<MailSender> m_mailSender;
   WebBaseSettings m_preferences;
   QEventLoop m_eventSynchonizer;
@@ -25,12 +25,58 @@
 #include "PlatformStatusCollector.hpp"
 #include "ctime"
 
+SourceFetchLimiter::SourceFetchLimiter(int maxFetchesPerSource)
+  : m_maxFetchesPerSource(qMax(1, maxFetchesPerSource))
+{
+}
+
+
+void SourceFetchLimiter::acquire(const QString& sid)
+{
+  sourceSemaphore(sid)->acquire();
+}
+
+
+void SourceFetchLimiter::release(const QString& sid)
+{
+  sourceSemaphore(sid)->release();
+}
+
+
+std::shared_ptr<QSemaphore> SourceFetchLimiter::sourceSemaphore(const QString& sid)
+{
+  QMutexLocker locker(&m_mutex);
+  auto semaphore = m_semaphores.find(sid);
+  if (semaphore == m_semaphores.end()) {
+    semaphore = m_semaphores.insert(sid, std::make_shared<QSemaphore>(m_maxFetchesPerSource));
+  }
+  return *semaphore;
+}
+
+
 PlatformStatusCollector::PlatformStatusCollector(void)
-  : DashboardBase(nullptr)
+  : DashboardBase(nullptr),
+    m_sourceFetchLimiter(nullptr)
 {
 }
 
 
+void PlatformStatusCollector::beginSourceUpdate(const SourceT& src)
+{
+  if (m_sourceFetchLimiter) {
+    m_sourceFetchLimiter->acquire(src.id);
+  }
+}
+
+
+void PlatformStatusCollector::endSourceUpdate(const SourceT& src)
+{
+  if (m_sourceFetchLimiter) {
+    m_sourceFetchLimiter->release(src.id);
+  }
+}
+
+
 void PlatformStatusCollector::updateChart(void)
 {
   CheckStatusCountT statsData;
@@ -46,4 +92,30 @@ void PlatformStatusCollector::updateChart(void)
   m_info.major     = static_cast<float>(m_chartBase.statusRatio(ngrt4n::Major));
   m_info.critical  = static_cast<float>(m_chartBase.statusRatio(ngrt4n::Critical));
   m_info.unknown   = static_cast<float>(m_chartBase.statusRatio(ngrt4n::Unknown));
+
+  QHash<QString, qint32> severities;
+  recordStatusTransitions(m_cdata.bpnodes, m_info.timestamp, severities);
+  recordStatusTransitions(m_cdata.cnodes, m_info.timestamp, severities);
+  m_lastSeverities.swap(severities);
+}
+
+
+void PlatformStatusCollector::recordStatusTransitions(const NodeListT& nodes, qint64 timestamp, QHash<QString, qint32>& severities)
+{
+  for (const auto& node: nodes) {
+    auto lastSeverity = m_lastSeverities.constFind(node.id);
+    if (lastSeverity == m_lastSeverities.cend() || *lastSeverity != node.sev) {
+      qint8 oldSeverity = lastSeverity == m_lastSeverities.cend() ? -1 : static_cast<qint8>(*lastSeverity);
+      m_statusTransitions.push_back(StatusTransitionT{node.id, timestamp, oldSeverity, static_cast<qint8>(node.sev)});
+    }
+    severities.insert(node.id, node.sev);
+  }
+}
+
+
+StatusTransitionListT PlatformStatusCollector::takeStatusTransitions(void)
+{
+  StatusTransitionListT transitions;
+  transitions.swap(m_statusTransitions);
+  return transitions;
 }
@@ -28,15 +28,45 @@
 #include "dbo/src/DbObjects.hpp"
 #include "dbo/src/DbSession.hpp"
 #include "ChartBase.hpp"
+#include "StatusJournal.hpp"
+#include <QMutex>
+#include <QSemaphore>
+#include <memory>
+
+/**
+ * @brief Caps the number of collectors that query the same data source at once.
+ * Shared by all the collectors of the reporting daemon, whatever the thread they run in.
+ */
+class SourceFetchLimiter
+{
+public:
+  SourceFetchLimiter(int maxFetchesPerSource);
+  void acquire(const QString& sid);
+  void release(const QString& sid);
+
+private:
+  int m_maxFetchesPerSource;
+  QMutex m_mutex;
+  QHash<QString, std::shared_ptr<QSemaphore>> m_semaphores;
+
+  std::shared_ptr<QSemaphore> sourceSemaphore(const QString& sid);
+};
+
 
 class PlatformStatusCollector : public DashboardBase
 {
 public:
   PlatformStatusCollector(void);
   PlatformStatusT info(void) const {return m_info;}
+  void setSourceFetchLimiter(SourceFetchLimiter* limiter) {m_sourceFetchLimiter = limiter;}
+  StatusTransitionListT takeStatusTransitions(void);
+  void setLastSeverities(const QHash<QString, qint32>& severities) {m_lastSeverities = severities;}
 
 protected:
   virtual void updateChart(void);
+  virtual int parsingMode(void) const {return Parser::ParsingModeCollector;}
+  virtual void beginSourceUpdate(const SourceT& src);
+  virtual void endSourceUpdate(const SourceT& src);
   virtual void buildMap(void) {}
   virtual void updateMap(const NodeT&, const QString&) {}
   virtual void buildTree(void) {}
@@ -47,6 +77,11 @@ protected:
 private:
   ChartBase m_chartBase;
   PlatformStatusT m_info;
+  SourceFetchLimiter* m_sourceFetchLimiter;
+  QHash<QString, qint32> m_lastSeverities;
+  StatusTransitionListT m_statusTransitions;
+
+  void recordStatusTransitions(const NodeListT& nodes, qint64 timestamp, QHash<QString, qint32>& severities);
 };
 
 #endif // REPORTCOLLECTOR_HPP
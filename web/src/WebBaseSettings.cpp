@@ -117,6 +117,17 @@ std::string WebBaseSettings::getDbPassword(void) const
   return SettingFactory::base64Decode(SettingFactory().keyValue(SettingFactory::DB_PASSWORD).toStdString());
 }
 
+int WebBaseSettings::getDbConnectionPoolSize(void) const
+{
+  QString v = QString::fromLocal8Bit(qgetenv("REALOPINSIGHT_DB_CONNECTION_POOL_SIZE"));
+  if (v.isEmpty()) {
+    v = SettingFactory().keyValue(SettingFactory::DB_CONNECTION_POOL_SIZE);
+  }
+  bool ok = false;
+  int poolSize = v.toInt(&ok);
+  return (ok && poolSize > 0) ? poolSize : 10;
+}
+
 std::string WebBaseSettings::getDbConnectionName(void) const
 {
   std::string cn = "";
@@ -54,6 +54,7 @@ public:
   std::string getDbPassword(void) const;
   std::string getDbConnectionName(void) const;
   std::string getDbConnectionNameDebug(void) const;
+  int getDbConnectionPoolSize(void) const;
   std::string getLdapIdField(void) const;
   int getLdapVersion(void) const;
   bool getLdapSslUseMyCert(void) const;
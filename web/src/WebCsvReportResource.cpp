@@ -1,14 +1,23 @@
 #include "WebCsvReportResource.hpp"
 #include <Wt/Http/Request.h>
 #include <Wt/Http/Response.h>
+#include <Wt/Http/ResponseContinuation.h>
 #include <Wt/WImage.h>
 
 
+namespace {
+  const int CSV_EXPORT_CHUNK_ENTRIES = 5000;
+}
+
 
-WebCsvExportResource::WebCsvExportResource(void)
-  : Wt::WResource()
+WebCsvExportResource::WebCsvExportResource(DbSession* dbSession)
+  : Wt::WResource(),
+    m_dbSession(dbSession),
+    m_startDate(0),
+    m_endDate(0)
 {
-  m_platformStatusData.clear();
+  // the database session belongs to the application, it must not be used concurrently with it
+  setTakesUpdateLock(true);
 }
 
 void WebCsvExportResource::setExportFileName(void)
@@ -22,29 +31,51 @@ void WebCsvExportResource::setExportFileName(void)
 }
 
 
-void WebCsvExportResource::updateData(const std::string& vname, const ListofPlatformStatusT& qosData)
+void WebCsvExportResource::updateData(const std::string& vname, long startDate, long endDate)
 {
-  m_platformStatusData.clear();
-  std::copy(qosData.begin(), qosData.end(), std::back_inserter(m_platformStatusData));
   m_vname = vname;
+  m_startDate = startDate;
+  m_endDate = endDate;
 }
 
 
-void WebCsvExportResource::handleRequest(const Wt::Http::Request&, Wt::Http::Response& response)
+void WebCsvExportResource::handleRequest(const Wt::Http::Request& request, Wt::Http::Response& response)
 {
-  setExportFileName();
-  response.setMimeType("text/csv");
-  response.out() << "Timestamp,Platform Name,Status,Normal (%),Minor (%),Major (%),Critical (%),Unknown (%)\n";
-  for (const auto& entry: m_platformStatusData) {
-    response.out() << entry.toString() << std::endl;
+  std::shared_ptr<StatusHistoryCursorT> cursor;
+  if (request.continuation()) {
+    cursor = Wt::cpp17::any_cast<std::shared_ptr<StatusHistoryCursorT>>(request.continuation()->data());
+  } else {
+    setExportFileName();
+    response.setMimeType("text/csv");
+    response.out() << "Timestamp,Platform Name,Status,Normal (%),Minor (%),Major (%),Critical (%),Unknown (%),Resolution (s)\n";
+    cursor = std::make_shared<StatusHistoryCursorT>(m_vname, m_startDate, m_endDate);
+  }
+
+  ListofPlatformStatusT entries;
+  if (m_dbSession->fetchStatusHistory(*cursor, entries, CSV_EXPORT_CHUNK_ENTRIES) < 0) {
+    CORE_LOG("error", QObject::tr("CSV export of view %1 interrupted").arg(m_vname.c_str()).toStdString());
+    // the status can no longer be changed once a chunk has been sent, the file is then explicitly marked as incomplete
+    if (! request.continuation()) {
+      response.setStatus(500);
+    }
+    response.out() << "ERROR,export interrupted by a database error, the data above are incomplete\n";
+    return;
+  }
+  for (const auto& entry: entries) {
+    response.out() << entry.toString() << '\n';
+  }
+
+  // the request is handled again for the next chunk once this one has been sent
+  if (! cursor->atEnd) {
+    response.createContinuation()->setData(cursor);
   }
 }
 
 
-WebCsvExportIcon::WebCsvExportIcon(void)
+WebCsvExportIcon::WebCsvExportIcon(DbSession* dbSession)
   : Wt::WAnchor()
 {
-  m_csvResource = std::make_shared<WebCsvExportResource>();
+  m_csvResource = std::make_shared<WebCsvExportResource>(dbSession);
   Wt::WLink link(m_csvResource);
   link.setTarget(Wt::LinkTarget::NewWindow);
   setLink(link);
@@ -53,7 +84,7 @@ WebCsvExportIcon::WebCsvExportIcon(void)
 }
 
 
-void WebCsvExportIcon::updateData(const std::string& vname, const ListofPlatformStatusT& statusData)
+void WebCsvExportIcon::updateData(const std::string& vname, long startDate, long endDate)
 {
-  m_csvResource->updateData(vname, statusData);
+  m_csvResource->updateData(vname, startDate, endDate);
 }
@@ -5,20 +5,26 @@
 #include <Wt/WResource.h>
 #include <Wt/WAnchor.h>
 
+/**
+ * Streams the raw status history of a view as CSV. Entries are read from a database cursor
+ * and written in chunks, each chunk being sent before the next one is fetched.
+ */
 class WebCsvExportResource : public Wt::WResource
 {
 public:
-  WebCsvExportResource(void);
+  WebCsvExportResource(DbSession* dbSession);
   ~WebCsvExportResource(){ beingDeleted(); }
-  void updateData(const std::string& viewName, const ListofPlatformStatusT& qosData);
+  void updateData(const std::string& viewName, long startDate, long endDate);
   void setExportFileName(void);
 
-  virtual void handleRequest(const Wt::Http::Request&, Wt::Http::Response& response);
+  virtual void handleRequest(const Wt::Http::Request& request, Wt::Http::Response& response);
 
 
 private:
-  ListofPlatformStatusT m_platformStatusData;
+  DbSession* m_dbSession;
   std::string m_vname;
+  long m_startDate;
+  long m_endDate;
 };
 
 
@@ -26,8 +32,8 @@ private:
 class WebCsvExportIcon : public Wt::WAnchor
 {
 public:
-  WebCsvExportIcon(void);
-  void updateData(const std::string& vname, const ListofPlatformStatusT& platformStatusData);
+  WebCsvExportIcon(DbSession* dbSession);
+  void updateData(const std::string& vname, long startDate, long endDate);
 
 private:
   std::shared_ptr<WebCsvExportResource> m_csvResource;
@@ -117,6 +117,32 @@ void WebDashboard::updateMap(void)
 }
 
 
+void WebDashboard::addDynamicNode(const NodeT& node)
+{
+  m_treeRef->insertNodeItem(node);
+}
+
+
+void WebDashboard::removeDynamicNode(const NodeT& node)
+{
+  m_treeRef->removeNodeItem(node.id);
+  m_eventConsoleRef->removeNodeMsg(node);
+
+  auto eventItem = m_eventItems.find(node.id);
+  if (m_eventFeedLayout && eventItem != m_eventItems.end()) {
+    auto itemPtr = m_eventFeedLayout->removeWidget(*eventItem);
+    itemPtr.reset(nullptr);
+    m_eventItems.erase(eventItem);
+  }
+}
+
+
+void WebDashboard::updateDynamicLayout(void)
+{
+  buildMap();
+}
+
+
 void WebDashboard::updateEventFeeds(const NodeT &node)
 {
   if (! m_eventFeedLayout) {
@@ -148,9 +174,9 @@ std::unique_ptr<Wt::WWidget> WebDashboard::createEventFeedTpl(const NodeT& node)
   page->bindWidget("event-feed-title", std::move(anchor));
   page->bindString("severity-css-class", ngrt4n::severityCssClass(node.sev));
   page->bindString("event-feed-icon", ngrt4n::NodeIcons[node.icon]);
-  page->bindString("event-feed-details", node.check.alarm_msg);
+  page->bindString("event-feed-details", node.check->alarm_msg);
   page->bindString("platform", vname);
-  page->bindString("timestamp", ngrt4n::wTimeToNow(node.check.last_state_change));
+  page->bindString("timestamp", ngrt4n::wTimeToNow(node.check->last_state_change));
 
   return std::move(page);
 }
@@ -89,6 +89,9 @@ protected:
   virtual void updateMsgConsole(const NodeT& node);
   virtual void updateChart(void);
   virtual void updateEventFeeds(const NodeT& node);
+  virtual void addDynamicNode(const NodeT& node);
+  virtual void removeDynamicNode(const NodeT& node);
+  virtual void updateDynamicLayout(void);
 
 Q_SIGNALS:
   void dashboardSelected(std::string viewName);
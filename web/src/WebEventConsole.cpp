@@ -91,15 +91,15 @@ void WebMsgConsole::updateNodeMsg(const NodeT& _node)
   int index = findServiceRow(_node.id.toStdString());
   if (index < 0) {
     int row = m_modelRef->rowCount();
-    m_modelRef->setItem(row, 0, createDateItem(_node.check.last_state_change, row));
+    m_modelRef->setItem(row, 0, createDateItem(_node.check->last_state_change, row));
     m_modelRef->setItem(row, 1, ngrt4n::createSeverityStandardItem(_node));
-    m_modelRef->setItem(row, 2, createItem(_node.check.host, row));
+    m_modelRef->setItem(row, 2, createItem(_node.check->host, row));
     m_modelRef->setItem(row, 3, createItem(_node.name.toStdString(), row));
     m_modelRef->setItem(row, 4, createItem(Wt::WString::fromUTF8(_node.actual_msg.toStdString()), row));
     m_modelRef->setItem(row, 5, createItem(_node.id.toStdString(), row));
   } else {
-    m_modelRef->item(index, 0)->setText(ngrt4n::humanTimeText(_node.check.last_state_change));
-    m_modelRef->item(index, 2)->setText(_node.check.host);
+    m_modelRef->item(index, 0)->setText(ngrt4n::humanTimeText(_node.check->last_state_change));
+    m_modelRef->item(index, 2)->setText(_node.check->host);
     m_modelRef->item(index, 3)->setText(_node.name.toStdString()); //optional
     m_modelRef->item(index, 4)->setText(Wt::WString::fromUTF8(_node.actual_msg.toStdString()));
 
@@ -108,6 +108,14 @@ void WebMsgConsole::updateNodeMsg(const NodeT& _node)
   sortByColumn(1, Wt::SortOrder::Descending);
 }
 
+void WebMsgConsole::removeNodeMsg(const NodeT& _node)
+{
+  int index = findServiceRow(_node.id.toStdString());
+  if (index >= 0) {
+    m_modelRef->removeRow(index);
+  }
+}
+
 
 std::unique_ptr<Wt::WStandardItem> WebMsgConsole::createItem(const Wt::WString& text, int row)
 {
@@ -58,6 +58,7 @@ public:
 
   Wt::WStandardItemModel* getRenderingModel(void) const {return m_modelRef;}
   void updateNodeMsg(const NodeT& _node);
+  void removeNodeMsg(const NodeT& _node);
   std::unique_ptr<Wt::WStandardItem> createItem(const Wt::WString& text, int row);
   std::unique_ptr<Wt::WStandardItem> createDateItem(const std::string& _lastcheck, int row);
 
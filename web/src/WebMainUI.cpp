@@ -28,6 +28,8 @@
 #include "utilsCore.hpp"
 #include "WebUtils.hpp"
 #include "WebInputField.hpp"
+#include "ViewDependencyGraph.hpp"
+#include "SettingFactory.hpp"
 #include <functional>
 #include <Wt/WApplication.h>
 #include <Wt/WToolBar.h>
@@ -58,9 +60,12 @@ WebMainUI::WebMainUI(AuthManager* authManager)
     m_currentAppBoard(nullptr),
     m_notificationManager(nullptr),
     m_eventFeedLayoutRef(nullptr),
+    m_thumbnailsLayoutRef(nullptr),
+    m_thumbnailCount(0),
     m_executiveViewPageRef(nullptr),
     m_platformStatusAnalyticsChartsRef(nullptr),
-    m_platformStatusAnalyticsPageRef(nullptr)
+    m_platformStatusAnalyticsPageRef(nullptr),
+    m_pollingScheduler(m_settings.updateInterval())
 {
   m_menuLabels[MenuExecutiveView] = Q_TR("Executive View");
   m_menuLabels[MenuPlatformStatusAnalytics] = Q_TR("Platform Availability Analytics");
@@ -294,7 +299,9 @@ Wt::WTemplate* WebMainUI::buildExecutiveViewPage(void)
 {
   auto executiveViewPageRef = m_opsStackRef->addNew<Wt::WTemplate>(Wt::WString::tr("ops-home.tpl"));
 
+  viewModelsChanged(); // records the generations the views are built from
   auto thumbnailsLayout = std::make_unique<Wt::WGridLayout>();
+  m_thumbnailsLayoutRef = thumbnailsLayout.get();
   auto eventFeedLayout = std::make_unique<Wt::WVBoxLayout>();
   m_eventFeedLayoutRef = eventFeedLayout.get();
   auto eventFeedItem = std::make_unique<Wt::WContainerWidget>();
@@ -312,9 +319,9 @@ Wt::WTemplate* WebMainUI::buildExecutiveViewPage(void)
     return executiveViewPageRef;
   }
 
-  // Generate view cards
-  int currentThumbailIndex = 0;
-  int cardPerRow = m_dbSession->boardCardsPerRow();
+  // Generate view cards, showing the last recorded status until the first update
+  PlatformStatusMapT lastStatuses;
+  m_dbSession->listLastPlatformStatuses(lastStatuses);
   std::string failuresCount = "";
   for (const auto& sv : listOfUserViews) {
     auto loadResult = loadView(sv.path);
@@ -326,18 +333,7 @@ Wt::WTemplate* WebMainUI::buildExecutiveViewPage(void)
     auto board = loadResult.first;
     //TODO want to replace Qt signal handling by the Wt's one
     QObject::connect(board, SIGNAL(dashboardSelected(std::string)), this, SLOT(handleDashboardSelected(std::string)));
-
-    auto thumbnail = std::make_unique<Wt::WTemplate>(Wt::WString::tr("dashboard-thumbnail.tpl"));
-    auto thumbnailTitle = board->thumbTitle();
-    thumbnail->setStyleClass("btn btn-unknown");
-    thumbnail->bindWidget("thumb-titlebar", std::make_unique<Wt::WLabel>(thumbnailTitle));
-    thumbnail->bindWidget("thumb-image", std::make_unique<Wt::WImage>(Wt::WLink(board->thumbURL())));
-
-    thumbnail->clicked().connect(std::bind(&WebMainUI::handleDashboardSelected, this, thumbnailTitle));
-    m_thumbnailComments[thumbnailTitle] = thumbnail->bindNew<Wt::WLabel>("thumb-problem-details", "");
-    m_thumbnails.insert(thumbnailTitle, thumbnail.get());
-    thumbnailsLayout->addWidget(std::move(thumbnail), currentThumbailIndex / cardPerRow, currentThumbailIndex % cardPerRow);
-    ++currentThumbailIndex;
+    addThumbnail(board, lastStatuses);
   }
 
   if (m_dbSession->displayOnlyTiles()) {
@@ -349,11 +345,11 @@ Wt::WTemplate* WebMainUI::buildExecutiveViewPage(void)
     doJavaScript("$('#ngrt4n-side-pane').removeClass().addClass('col-sm-4');");
   }
 
-  if (currentThumbailIndex > 0) {
+  if (m_thumbnailCount > 0) {
     startDashbaordUpdate();
   }
 
-  if (currentThumbailIndex != static_cast<int>(listOfUserViews.size())) {
+  if (m_thumbnailCount != static_cast<int>(listOfUserViews.size())) {
     showMessage(ngrt4n::OperationFailed, QObject::tr("Failed to load views => %1. Check details in logs").arg(failuresCount.c_str()).toStdString());
   }
   auto thumbnails = std::make_unique<Wt::WContainerWidget>();
@@ -363,6 +359,110 @@ Wt::WTemplate* WebMainUI::buildExecutiveViewPage(void)
   return executiveViewPageRef;
 }
 
+
+void WebMainUI::addThumbnail(WebDashboard* board, const PlatformStatusMapT& lastStatuses)
+{
+  if (! m_thumbnailsLayoutRef) {
+    return;
+  }
+  auto thumbnail = std::make_unique<Wt::WTemplate>(Wt::WString::tr("dashboard-thumbnail.tpl"));
+  auto thumbnailTitle = board->thumbTitle();
+  auto lastStatus = lastStatuses.constFind(thumbnailTitle);
+  thumbnail->setStyleClass(lastStatus != lastStatuses.cend() ? ngrt4n::thumbCss(lastStatus->status) : "btn btn-unknown");
+  thumbnail->bindWidget("thumb-titlebar", std::make_unique<Wt::WLabel>(thumbnailTitle));
+  thumbnail->bindWidget("thumb-image", std::make_unique<Wt::WImage>(Wt::WLink(board->thumbURL())));
+
+  thumbnail->clicked().connect(std::bind(&WebMainUI::handleDashboardSelected, this, thumbnailTitle));
+  m_thumbnailComments[thumbnailTitle] = thumbnail->bindNew<Wt::WLabel>("thumb-problem-details", "");
+  m_thumbnails.insert(thumbnailTitle, thumbnail.get());
+  int cardPerRow = m_dbSession->boardCardsPerRow();
+  m_thumbnailsLayoutRef->addWidget(std::move(thumbnail), m_thumbnailCount / cardPerRow, m_thumbnailCount % cardPerRow);
+  ++m_thumbnailCount;
+}
+
+
+bool WebMainUI::viewModelsChanged(void)
+{
+  bool changed = false;
+  for (int cachedData: {DbSession::CachedViews, DbSession::CachedSources, DbSession::CachedViewAssignments}) {
+    quint64 generation = DbSession::cachedDataGeneration(cachedData);
+    if (m_viewModelGenerations.value(cachedData) != generation) {
+      m_viewModelGenerations[cachedData] = generation;
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+
+void WebMainUI::reloadViewModels(void)
+{
+  CORE_LOG("info", QObject::tr("reloading views changed in database (operator: %1)").arg(m_dbSession->loggedUserName()).toStdString());
+
+  std::string selectedItem = m_boardSelectorRef->currentText().toUTF8();
+
+  QSet<QString> assignedViewNames;
+  PlatformStatusMapT lastStatuses;
+  m_dbSession->listLastPlatformStatuses(lastStatuses);
+  for (const auto& sv : m_dbSession->listAssignedViewsByUser(m_dbSession->loggedUser().username)) {
+    auto loadResult = loadView(sv.path);
+    if (! loadResult.first) {
+      CORE_LOG("error", loadResult.second.toStdString());
+      continue;
+    }
+    auto board = loadResult.first;
+    QObject::connect(board, SIGNAL(dashboardSelected(std::string)), this, SLOT(handleDashboardSelected(std::string)));
+    assignedViewNames.insert(board->rootNode().name);
+    if (! m_thumbnails.contains(board->thumbTitle())) {
+      addThumbnail(board, lastStatuses);
+    }
+  }
+
+  for (const auto& viewName: m_appBoards.keys()) {
+    if (! assignedViewNames.contains(viewName)) {
+      removeView(viewName);
+    }
+  }
+
+  // the analytics charts are built from the assigned views, they are rebuilt when next displayed
+  if (m_platformStatusAnalyticsPageRef) {
+    m_opsStackRef->removeWidget(m_platformStatusAnalyticsPageRef);
+    m_platformStatusAnalyticsPageRef = nullptr;
+    m_platformStatusAnalyticsChartsRef = nullptr;
+  }
+
+  // loading the views displayed them, the previous selection is restored
+  int selectedIndex = m_boardSelectorRef->findText(selectedItem);
+  m_boardSelectorRef->setCurrentIndex(selectedIndex >= 0 ? selectedIndex : m_boardSelectorRef->findText(m_menuLabels[MenuExecutiveView]));
+  handleBoardSelectionChanged();
+}
+
+
+void WebMainUI::removeView(const QString& viewName)
+{
+  auto loadedDashboardItem = m_appBoards.find(viewName);
+  if (loadedDashboardItem == m_appBoards.end()) {
+    return;
+  }
+  WebDashboard* dashboard = *loadedDashboardItem;
+  m_appBoards.erase(loadedDashboardItem);
+  if (m_currentAppBoard == dashboard) {
+    m_currentAppBoard = nullptr;
+  }
+  int selectorIndex = m_boardSelectorRef->findText(viewName.toStdString());
+  if (selectorIndex >= 0) {
+    m_boardSelectorRef->removeItem(selectorIndex);
+  }
+  auto thumb = m_thumbnails.find(viewName.toStdString());
+  if (thumb != m_thumbnails.end()) {
+    (*thumb)->setHidden(true);
+    m_thumbnails.erase(thumb);
+    m_thumbnailComments.remove(viewName.toStdString());
+  }
+  m_viewStatuses.remove(viewName);
+  m_opsStackRef->removeWidget(dashboard); // the returned ownership destroys the dashboard
+}
+
 Wt::WTemplate* WebMainUI::buildSlaAnalyticsPage(void)
 {
   auto statusAnalyticsPage = m_opsStackRef->addNew<Wt::WTemplate>(Wt::WString::tr("platform-status-analytics.tpl"));
@@ -373,16 +473,12 @@ Wt::WTemplate* WebMainUI::buildSlaAnalyticsPage(void)
     return statusAnalyticsPage;
   }
 
-  auto statusAnalyticsBoard = std::make_unique<WebPlatformStatusAnalyticsCharts>(assignedViews, m_dbSession->listSources(MonitorT::Any));
+  auto statusAnalyticsBoard = std::make_unique<WebPlatformStatusAnalyticsCharts>(assignedViews, m_dbSession->listSources(MonitorT::Any), m_dbSession);
   m_platformStatusAnalyticsChartsRef = statusAnalyticsBoard.get();
   m_platformStatusAnalyticsChartsRef->reportPeriodChanged().connect(this, &WebMainUI::handleReportPeriodChanged);
   statusAnalyticsPage->bindWidget("platform-analytics-board-charts", std::move(statusAnalyticsBoard));
 
-  for (const auto& view: assignedViews) {
-    PlatformMappedStatusHistoryT statusHistory;
-    m_dbSession->listStatusHistory(statusHistory, view.name, m_platformStatusAnalyticsChartsRef->startTime(), m_platformStatusAnalyticsChartsRef->endTime());
-    m_platformStatusAnalyticsChartsRef->updateByView(view.name, statusHistory);
-  }
+  handleReportPeriodChanged(m_platformStatusAnalyticsChartsRef->startTime(), m_platformStatusAnalyticsChartsRef->endTime());
 
   return statusAnalyticsPage;
 }
@@ -482,58 +578,113 @@ void WebMainUI::handleRefresh(void)
 
   m_globalTimer.stop();
 
-  std::map<int, int> appStates = {
-    {ngrt4n::Normal, 0},
-    {ngrt4n::Minor, 0},
-    {ngrt4n::Major, 0},
-    {ngrt4n::Critical, 0},
-    {ngrt4n::Unknown, 0},
-  };
+  // views, sources or assignments changed by other sessions or processes
+  if (! m_dbSession->isLoggedAdmin() && viewModelsChanged()) {
+    reloadViewModels();
+  }
 
-  // clear the notification manager when applicable
-  if (m_notificationManager) {
-    m_notificationManager->clearAllServicesData();
+  // each view is refreshed at its own interval, like in reportd; the views are added with a first deadline one period
+  // back, so that they are all due on the first refresh while keeping the jitter of their later deadlines
+  SettingFactory pollingSettings;
+  auto refreshTime = PollingScheduler::ClockT::now();
+  m_pollingScheduler.setDefaultInterval(m_settings.updateInterval());
+  m_pollingScheduler.setViewIntervals(pollingSettings.viewUpdateIntervals());
+  m_pollingScheduler.setSourceIntervals(pollingSettings.sourceUpdateIntervals());
+  QSet<QString> boardNames;
+  for (auto appBoard = m_appBoards.cbegin(); appBoard != m_appBoards.cend(); ++appBoard) {
+    boardNames.insert(appBoard.key());
+    if (! m_pollingScheduler.hasView(appBoard.key())) {
+      m_pollingScheduler.addView(appBoard.key(), refreshTime - std::chrono::seconds(m_pollingScheduler.viewInterval(appBoard.key())));
+    }
   }
+  m_pollingScheduler.retainViews(boardNames);
+  auto dueViews = m_pollingScheduler.dueViews(refreshTime);
 
-  int currentView = 1;
-  for (auto& currentBoard : m_appBoards) {
+  // boards referenced by external services are updated first, the referencing ones then read their status from memory
+  ViewDependencyGraph viewDependencies;
+  for (auto appBoard = m_appBoards.cbegin(); appBoard != m_appBoards.cend(); ++appBoard) {
+    viewDependencies.addView(appBoard.key(), (*appBoard)->externalViews());
+  }
+  QList<WebDashboard*> orderedBoards;
+  for (const auto& wave: viewDependencies.evaluationWaves()) {
+    for (const auto& appName: wave) {
+      if (dueViews.contains(appName)) {
+        orderedBoards.push_back(m_appBoards.value(appName));
+      }
+    }
+  }
+
+  // the sessions refreshing within the same update interval share a polling cycle of the source circuit breaker
+  quint64 updateCycle = static_cast<quint64>(time(nullptr) / qMax(1, m_settings.updateInterval()));
+
+  // a source shared by several boards counts for one failure or success per refresh in the back-off
+  QSet<QString> polledSources;
+  QSet<QString> failedSources;
+  for (auto& currentBoard : orderedBoards) {
+    NodeT currentRootNode = currentBoard->rootNode();
+    m_pollingScheduler.markCollected(currentRootNode.name, refreshTime);
     currentBoard->setDbSession(m_dbSession);
+    currentBoard->setUpdateCycle(updateCycle);
+    currentBoard->setViewStatuses(&m_viewStatuses);
     auto loadDsOut = currentBoard->loadDataSources();
     if (loadDsOut.first != ngrt4n::RcSuccess) {
       CORE_LOG("error", loadDsOut.second.toStdString());
+      m_viewStatuses.remove(currentRootNode.name);
       continue;
     }
     currentBoard->updateAllNodesStatus();
     currentBoard->updateMap();
-    NodeT currentRootNode = currentBoard->rootNode();
-    int overvallSeverity = qMin(currentRootNode.sev, static_cast<int>(ngrt4n::Unknown));
-    if (overvallSeverity != ngrt4n::Normal) {
-      ++appStates[overvallSeverity];
-      if (m_notificationManager) {
-        m_notificationManager->updateServiceData(currentRootNode);
-      }
-    }
+    m_pollingScheduler.setViewSources(currentRootNode.name, currentBoard->sourceIds());
+    polledSources.unite(currentBoard->sourceIds());
+    failedSources.unite(currentBoard->failedSources());
+    currentRootNode = currentBoard->rootNode();
+    m_viewStatuses.insert(currentRootNode.name, ViewStatusT{currentRootNode.sev, time(nullptr)});
     std::string vname = currentRootNode.name.toStdString();
     auto thumb = m_thumbnails.find(vname);
     if (thumb != m_thumbnails.end()) {
       (*thumb)->setStyleClass(currentBoard->thumbCss());
       (*thumb)->setToolTip(currentBoard->tooltip());
-      if (! m_dbSession->isLoggedAdmin() && m_platformStatusAnalyticsChartsRef) {
-        std::string currentView = m_boardSelectorRef->currentText().toUTF8();
-        if (currentView == m_menuLabels[MenuPlatformStatusAnalytics]) {
-          PlatformMappedStatusHistoryT platformStatusData;
-          m_dbSession->listStatusHistory(platformStatusData, vname, m_platformStatusAnalyticsChartsRef->startTime(), m_platformStatusAnalyticsChartsRef->endTime());
-          m_platformStatusAnalyticsChartsRef->updateByView(vname, platformStatusData);
-        }
-      }
     }
     auto thumbComment = m_thumbnailComments.find(vname);
     if (thumbComment != m_thumbnailComments.end()) {
       (*thumbComment)->setText(currentBoard->thumbMsg());
     }
+  }
+  for (const auto& sid: polledSources) {
+    if (failedSources.contains(sid)) {
+      m_pollingScheduler.reportSourceFailure(sid);
+    } else {
+      m_pollingScheduler.reportSourceSuccess(sid);
+    }
+  }
 
+  // the counters and the notification manager cover all the boards, including those not due in this refresh
+  std::map<int, int> appStates = {
+    {ngrt4n::Normal, 0},
+    {ngrt4n::Minor, 0},
+    {ngrt4n::Major, 0},
+    {ngrt4n::Critical, 0},
+    {ngrt4n::Unknown, 0},
+  };
+  if (m_notificationManager) {
+    m_notificationManager->clearAllServicesData();
+  }
+  for (const auto& appBoard: m_appBoards) {
+    NodeT rootNode = appBoard->rootNode();
+    int overvallSeverity = qMin(rootNode.sev, static_cast<int>(ngrt4n::Unknown));
+    if (overvallSeverity != ngrt4n::Normal) {
+      ++appStates[overvallSeverity];
+      if (m_notificationManager) {
+        m_notificationManager->updateServiceData(rootNode);
+      }
+    }
+  }
 
-    ++currentView;
+  // only the availability pies follow the refresh, the trend charts are reloaded when the report period changes
+  if (! m_dbSession->isLoggedAdmin()
+      && m_platformStatusAnalyticsChartsRef
+      && m_boardSelectorRef->currentText().toUTF8() == m_menuLabels[MenuPlatformStatusAnalytics]) {
+    updateSlaAnalytics(m_platformStatusAnalyticsChartsRef->startTime(), m_platformStatusAnalyticsChartsRef->endTime(), false);
   }
 
   // Display notifications only on operator console
@@ -553,7 +704,9 @@ void WebMainUI::handleRefresh(void)
            .arg(m_dbSession->loggedUserName(), wApp->sessionId().c_str())
            .toStdString());
 
-  m_globalTimer.setInterval(std::chrono::milliseconds(1000 * m_settings.updateInterval()));
+  // wakes up at the next deadline, at least a second later so that a refresh overrunning them doesn't spin
+  auto nextRefresh = std::chrono::duration_cast<std::chrono::milliseconds>(m_pollingScheduler.nextDeadline(PollingScheduler::ClockT::now()) - PollingScheduler::ClockT::now());
+  m_globalTimer.setInterval(qMax(nextRefresh, std::chrono::milliseconds(1000)));
   m_globalTimer.start();
 }
 
@@ -632,10 +785,25 @@ void WebMainUI::handleChangePassword(const std::string& login, const std::string
 
 void WebMainUI::handleReportPeriodChanged(long start, long end)
 {
-  PlatformMappedStatusHistoryT qosData;
-  m_dbSession->listStatusHistory(qosData, "ALL", start, end);
-  for (const auto& vname : qosData.keys()) {
-    m_platformStatusAnalyticsChartsRef->updateByView(vname, qosData);
+  updateSlaAnalytics(start, end, true);
+}
+
+
+/**
+ * Updates the analytics charts of the views assigned to the user. The pie charts only need the status
+ * durations, the status history is only read for the trend charts when reloadHistory is set.
+ */
+void WebMainUI::updateSlaAnalytics(long start, long end, bool reloadHistory)
+{
+  for (const auto& vname: m_platformStatusAnalyticsChartsRef->views()) {
+    StatusDurationMapT statusDurations;
+    m_dbSession->listStatusDurations(statusDurations, vname, start, end);
+    m_platformStatusAnalyticsChartsRef->updateByView(vname, statusDurations);
+    if (reloadHistory) {
+      PlatformMappedStatusHistoryT statusHistory;
+      m_dbSession->listStatusHistory(statusHistory, vname, start, end);
+      m_platformStatusAnalyticsChartsRef->updateTrendsByView(vname, statusHistory);
+    }
   }
 }
 
@@ -725,13 +893,18 @@ std::pair<WebDashboard*, QString> WebMainUI::loadView(const std::string& path)
     QString appName = myboard->rootNode().name;
     auto bfound = m_appBoards.find(appName);
     if (bfound != m_appBoards.end()) {
-      m_opsStackRef->removeWidget(*bfound);
-      m_appBoards.remove(appName);
-      delete *bfound;
+      WebDashboard* previousBoard = *bfound;
+      m_appBoards.erase(bfound);
+      if (m_currentAppBoard == previousBoard) {
+        m_currentAppBoard = nullptr;
+      }
+      m_opsStackRef->removeWidget(previousBoard); // the returned ownership destroys the board
     }
 
     m_appBoards.insert(appName, myboard);
-    m_boardSelectorRef->addItem(appName.toStdString());
+    if (m_boardSelectorRef->findText(appName.toStdString()) < 0) {
+      m_boardSelectorRef->addItem(appName.toStdString());
+    }
     if (m_eventFeedLayoutRef) {
       myboard->setEventFeedLayout(m_eventFeedLayoutRef);
     }
@@ -945,13 +1118,7 @@ void  WebMainUI::handleViewAclMenu(void)
 
 void WebMainUI::handleDeleteView(const std::string& viewName)
 {
-  auto loadedDashboardItem = m_appBoards.find(viewName.c_str());
-  if (loadedDashboardItem != m_appBoards.end()) {
-    WebDashboard* dashboard = *loadedDashboardItem;
-    m_opsStackRef->removeWidget(dashboard);
-    delete (*loadedDashboardItem);
-    m_appBoards.remove(viewName.c_str());
-  }
+  removeView(viewName.c_str());
 }
 
 
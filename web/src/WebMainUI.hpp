@@ -40,6 +40,7 @@
 #include "WebCsvReportResource.hpp"
 #include "WebInputField.hpp"
 #include "WebEditor.hpp"
+#include "PollingScheduler.hpp"
 #include <Wt/WComboBox.h>
 #include <Wt/WTimer.h>
 #include <Wt/WApplication.h>
@@ -154,6 +155,7 @@ private:
   Wt::WStackedWidget* m_opsStackRef;
 
   QMap<QString, WebDashboard*> m_appBoards;
+  ViewStatusMapT m_viewStatuses;
   Wt::WText* m_adminPageTitleRef;
   WebInputField m_previewInput;
 
@@ -161,9 +163,13 @@ private:
   Wt::WVBoxLayout* m_eventFeedLayoutRef;
   QMap<std::string, Wt::WTemplate*>  m_thumbnails;
   QMap<std::string, Wt::WLabel*>  m_thumbnailComments;
+  Wt::WGridLayout* m_thumbnailsLayoutRef;
+  int m_thumbnailCount;
+  QMap<int, quint64> m_viewModelGenerations; // cached data generations the loaded views were built from
   Wt::WTemplate* m_executiveViewPageRef;
   WebPlatformStatusAnalyticsCharts* m_platformStatusAnalyticsChartsRef;
   Wt::WTemplate* m_platformStatusAnalyticsPageRef;
+  PollingScheduler m_pollingScheduler; // deadlines of the boards, refreshed on their own intervals
 
 
   /** callbacks */
@@ -202,7 +208,12 @@ private:
   bool createDirectory(const std::string& path, bool cleanContent);
   Wt::WTemplate* buildExecutiveViewPage(void);
   Wt::WTemplate* buildSlaAnalyticsPage(void);
+  void updateSlaAnalytics(long start, long end, bool reloadHistory);
   std::pair<WebDashboard*, QString> loadView(const std::string& path);
+  void addThumbnail(WebDashboard* board, const PlatformStatusMapT& lastStatuses);
+  void removeView(const QString& viewName);
+  bool viewModelsChanged(void);
+  void reloadViewModels(void);
   std::unique_ptr<Wt::WWidget> createDisplayOptionsToolbar(void);
   std::shared_ptr<Wt::WDialog> createAboutDialog(void);
   std::unique_ptr<Wt::WAnchor> createLogoLink(void);
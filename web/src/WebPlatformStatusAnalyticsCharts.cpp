@@ -28,7 +28,7 @@
 #include <regex>
 
 
-WebPlatformStatusAnalyticsCharts::WebPlatformStatusAnalyticsCharts(const DbViewsT& listOfViews, const SourceListT& listOfSources)
+WebPlatformStatusAnalyticsCharts::WebPlatformStatusAnalyticsCharts(const DbViewsT& listOfViews, const SourceListT& listOfSources, DbSession* dbSession)
   : m_layoutRef(nullptr),
     m_dateFilterRef(nullptr)
 {
@@ -60,7 +60,7 @@ WebPlatformStatusAnalyticsCharts::WebPlatformStatusAnalyticsCharts(const DbViews
     auto slaReportChart = row->bindNew<WebPieChart>("platform-availability-chart", ChartBase::SLAData);
     m_slaReportsRef.insert(view.name, slaReportChart);
 
-    auto csvExportIcon = row->bindNew<WebCsvExportIcon>("platform-availability-csv-export");
+    auto csvExportIcon = row->bindNew<WebCsvExportIcon>("platform-availability-csv-export", dbSession);
     m_csvLinksRef.insert(view.name, csvExportIcon);
 
     layout->addWidget(std::move(row));
@@ -73,32 +73,29 @@ WebPlatformStatusAnalyticsCharts::WebPlatformStatusAnalyticsCharts(const DbViews
 WebPlatformStatusAnalyticsCharts::~WebPlatformStatusAnalyticsCharts() {}
 
 
-void WebPlatformStatusAnalyticsCharts::updateByView(const std::string& vname, const PlatformMappedStatusHistoryT& statusHistory)
+void WebPlatformStatusAnalyticsCharts::updateByView(const std::string& vname, const StatusDurationMapT& statusDurations)
 {
-  PlatformMappedStatusHistoryT::ConstIterator statusHistoryFound = statusHistory.find(vname);
-  if (statusHistoryFound == statusHistory.end()) {
-    CORE_LOG("warn", QObject::tr("view not found to update chart %1").arg(vname.c_str()).toStdString());
-    return;
-  }
-
-  // process update since view found
+  // durations are computed by the database, a view without data in the period has none
   QMap<std::string, WebPieChart*>::iterator iterSlaPiechart = m_slaReportsRef.find(vname);
   if (iterSlaPiechart != m_slaReportsRef.end()) {
-    WebPlatformStatusAnalyticsData statusAnalyticsData(*statusHistoryFound);
-    (*iterSlaPiechart)->setSeverityData(statusAnalyticsData.normalDuration(), statusAnalyticsData.minorDuration(), statusAnalyticsData.majorDuration(), statusAnalyticsData.criticalDuration(), statusAnalyticsData.totalDuration());
+    auto durations = statusDurations.value(vname);
+    (*iterSlaPiechart)->setSeverityData(durations.normal, durations.minor, durations.major, durations.critical, qMax(durations.total(), 1L));
     (*iterSlaPiechart)->repaint();
   }
 
-  // update IT problem chart when applicable
-  QMap<std::string, WebPlatformStatusRaw*>::iterator iterProblemTrendsChart = m_problemReportRef.find(vname);
-  if (iterProblemTrendsChart != m_problemReportRef.end()) {
-    (*iterProblemTrendsChart)->updateData(*statusHistoryFound);
-  }
-
-  // update QoS data for export
+  // update the range of QoS data for export, the data are streamed from the database on download
   QMap<std::string, WebCsvExportIcon*>::iterator iterCsvExportItem = m_csvLinksRef.find(vname);
   if (iterCsvExportItem != m_csvLinksRef.end()) {
-    (*iterCsvExportItem)->updateData(vname, *statusHistoryFound);
+    (*iterCsvExportItem)->updateData(vname, startTime(), endTime());
+  }
+}
+
+
+void WebPlatformStatusAnalyticsCharts::updateTrendsByView(const std::string& vname, const PlatformMappedStatusHistoryT& statusHistory)
+{
+  QMap<std::string, WebPlatformStatusRaw*>::iterator iterProblemTrendsChart = m_problemReportRef.find(vname);
+  if (iterProblemTrendsChart != m_problemReportRef.end()) {
+    (*iterProblemTrendsChart)->updateData(statusHistory.value(vname));
   }
 }
 
@@ -25,7 +25,6 @@
 #ifndef WEBBIDASHLET_HPP
 #define WEBBIDASHLET_HPP
 
-#include "WebPlatformStatusAnalyticsData.hpp"
 #include "WebPlatformStatusRaw.hpp"
 #include "WebPieChart.hpp"
 #include "WebPlatformStatusDateFilter.hpp"
@@ -41,9 +40,11 @@ class WebPlatformStatusAnalyticsCharts : public QObject, public Wt::WContainerWi
   Q_OBJECT
 
 public:
-  WebPlatformStatusAnalyticsCharts(const DbViewsT& listOfViews, const SourceListT& listOfSources);
+  WebPlatformStatusAnalyticsCharts(const DbViewsT& listOfViews, const SourceListT& listOfSources, DbSession* dbSession);
   ~WebPlatformStatusAnalyticsCharts();
-  void updateByView (const std::string& vame, const PlatformMappedStatusHistoryT& statusHistory);
+  void updateByView(const std::string& vname, const StatusDurationMapT& statusDurations);
+  void updateTrendsByView(const std::string& vname, const PlatformMappedStatusHistoryT& statusHistory);
+  QList<std::string> views(void) const { return m_slaReportsRef.keys(); }
   long startTime(void) {return m_dateFilterRef->epochStartTime();}
   long endTime(void) {return m_dateFilterRef->epochEndTime();}
   Wt::Signal<long, long>& reportPeriodChanged() { return m_reportPeriodChanged; }
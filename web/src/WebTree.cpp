@@ -112,17 +112,49 @@ void WebTree::registerNodeItem(const NodeT& nodeInfo, const QString& parentId, b
   item->setText(Wt::WString(nodeInfo.name.toStdString()));
   item->setIcon("images/built-in/unknown.png");
   item->setData(nodeInfo.id, Wt::ItemDataRole::User);
-  m_itemsRef[nodeInfo.id] = item.get();
+  auto itemRef = item.get();
+  m_itemsRef[nodeInfo.id] = itemRef;
 
+  // the item must be owned by the registry before binding, since binding moves it under its parent
+  m_registeredItems[nodeInfo.id] = std::move(item);
   if (! parentId.isEmpty()) {
     bindChildToParent(nodeInfo.id, parentId);
   }
 
   if (selectNewNode) {
-    select(item->index());
+    select(itemRef->index());
   }
+}
 
-  m_registeredItems[nodeInfo.id] = std::move(item);
+
+void WebTree::insertNodeItem(const NodeT& nodeInfo)
+{
+  if (m_itemsRef.find(nodeInfo.id) != m_itemsRef.end()) {
+    return;
+  }
+  // a dynamic view node has a single parent
+  QString parentId = nodeInfo.parents.isEmpty() ? "" : *(nodeInfo.parents.begin());
+  registerNodeItem(nodeInfo, parentId, false);
+  auto item = findItemByNodeId(nodeInfo.id);
+  if (item) {
+    item->setIcon(ngrt4n::getIconPath(nodeInfo.sev).toStdString());
+  }
+}
+
+
+void WebTree::removeNodeItem(const QString& nodeId)
+{
+  auto item = findItemByNodeId(nodeId);
+  if (! item) {
+    return;
+  }
+  m_itemsRef.erase(nodeId);
+  auto parentItem = item->parent();
+  if (parentItem) {
+    parentItem->removeRow(item->row());
+  }
+  // releases the item when it was never bound to a parent
+  m_registeredItems.erase(nodeId);
 }
 
 
@@ -137,10 +169,10 @@ void WebTree::bindChildToParent(const QString& childId, const QString& parentId)
 {
   auto citem = m_registeredItems.find(childId);
   auto pitemRef = findItemByNodeId(parentId);
-  if (pitemRef != nullptr && citem !=  m_registeredItems.end()) {
+  if (pitemRef != nullptr && citem != m_registeredItems.end() && citem->second) {
     pitemRef->appendRow(std::move(citem->second));
   } else {
-    CORE_LOG("debug", QObject::tr("ignoring dependency with child or parent not found").arg(parentId, childId).toStdString());
+    CORE_LOG("debug", QObject::tr("ignoring dependency %1 -> %2 with child or parent not found").arg(parentId, childId).toStdString());
   }
 }
 
@@ -43,6 +43,8 @@ class WebTree : public Wt::WTreeView
     void build(void);
     void activateEditionFeatures(void);
     void registerNodeItem(const NodeT& nodeInfo, const QString& parentId, bool selectNewNode);
+    void insertNodeItem(const NodeT& nodeInfo);
+    void removeNodeItem(const QString& nodeId);
     QString findNodeIdFromTreeItem(const Wt::WModelIndex& index) const;
     void expandNodeById(const QString& nodeId);
     void selectNodeById(const QString& nodeId);
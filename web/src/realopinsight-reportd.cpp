@@ -24,29 +24,230 @@
 
 #include "WebBaseSettings.hpp"
 #include "PlatformStatusCollector.hpp"
+#include "PollingScheduler.hpp"
+#include "ViewDependencyGraph.hpp"
+#include "DbConnectionPool.hpp"
+#include "DbChangeListener.hpp"
+#include "DbWriteQueue.hpp"
 #include "WebUtils.hpp"
 #include "WebApplication.hpp"
 #include "Notificator.hpp"
 #include "utils/smtpclient/MailSender.hpp"
 #include <unistd.h>
+#include <csignal>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <QString>
+#include <QThreadPool>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QCoreApplication>
+#include <QRunnable>
 #include <getopt.h>
 #include <unistd.h>
 #include <regex>
+#include <vector>
+#include <map>
+#include <memory>
+#include <thread>
+#include <algorithm>
+#include <prometheus/counter.h>
 #include <prometheus/gauge.h>
 #include <prometheus/exposer.h>
 #include <prometheus/registry.h>
 
-void wait_for_interval(int interval)
+/**
+ * View model kept from one cycle to the next, it's only rebuilt when
+ * the view record or the content of the view file changes.
+ * The file is only hashed again when its modification time or size changes.
+ */
+struct ViewModelT {
+  std::unique_ptr<PlatformStatusCollector> collector;
+  std::string path;
+  int serviceCount = -1;
+  QDateTime fileModified;
+  qint64 fileSize = -1;
+  QByteArray contentHash;
+  QString statusName;
+};
+
+
+volatile std::sig_atomic_t shutdownRequested = 0;
+
+void requestShutdown(int)
+{
+  shutdownRequested = 1;
+}
+
+
+QByteArray viewContentHash(const std::string& path)
+{
+  QFile file(path.c_str());
+  if (! file.open(QIODevice::ReadOnly)) {
+    return QByteArray();
+  }
+  return QCryptographicHash::hash(file.readAll(), QCryptographicHash::Sha1);
+}
+
+
+/**
+ * Name under which the status of a view is recorded, and referenced by external services
+ */
+std::string viewStatusName(const DboView& view, const std::string& rootName)
+{
+  if (rootName != view.name && std::regex_match(view.name, std::regex("Source[0-9]:.+"))) {
+    return view.name;
+  }
+  return rootName;
+}
+
+
+/**
+ * Retention in seconds of the status data of each tier, by tier resolution (0 for raw samples)
+ */
+QMap<long, long> statusRetentions(const QMap<QString, qint32>& retentionDays)
+{
+  const QMap<QString, long> TIER_RESOLUTIONS = {{"raw", 0}, {"5m", 300}, {"1h", 3600}, {"1d", 86400}};
+  QMap<long, long> retentions;
+  for (auto days = retentionDays.cbegin(); days != retentionDays.cend(); ++days) {
+    if (TIER_RESOLUTIONS.contains(days.key())) {
+      retentions.insert(TIER_RESOLUTIONS.value(days.key()), days.value() * 86400L);
+    }
+  }
+  return retentions;
+}
+
+
+struct ViewCollectionResultT {
+  int rc = ngrt4n::RcGenericFailure;
+  QString errorMsg;
+  PlatformStatusT platformStatus;
+  NodeT rootNode;
+  QSet<QString> sourceIds;
+  QSet<QString> failedSources;
+  StatusTransitionListT statusTransitions;
+  bool modelLoaded = false; // the collector was created for this cycle
+  std::unique_ptr<PlatformStatusCollector> replacedCollector; // destroyed by the main thread with the results
+};
+
+
+/**
+ * Each worker thread of the pool keeps its own database session,
+ * Wt::Dbo sessions must not be shared between threads.
+ */
+DbSession& workerDbSession(void)
 {
-  unsigned int remaining = static_cast<unsigned int>(interval);
-  while ((remaining = sleep(remaining)) > 0);
+  thread_local DbSession dbSession;
+  return dbSession;
 }
 
-void runCollector(int period)
+
+class ViewLoadingTask : public QRunnable
+{
+public:
+  ViewLoadingTask(const DboView& view, ViewModelT* model, ViewCollectionResultT* result)
+    : m_view(view),
+      m_model(model),
+      m_result(result) { }
+
+  void run(void) override {
+    const bool sameRecord = m_model->collector
+        && m_model->path == m_view.path
+        && m_model->serviceCount == m_view.service_count;
+    QFileInfo fileInfo(m_view.path.c_str());
+    const QDateTime fileModified = fileInfo.lastModified();
+    const qint64 fileSize = fileInfo.size();
+    if (sameRecord && m_model->fileModified == fileModified && m_model->fileSize == fileSize) {
+      return;
+    }
+
+    auto contentHash = viewContentHash(m_view.path);
+    if (sameRecord && m_model->contentHash == contentHash) {
+      m_model->fileModified = fileModified;
+      m_model->fileSize = fileSize;
+      return;
+    }
+
+    m_result->replacedCollector = std::move(m_model->collector);
+    auto collector = std::make_unique<PlatformStatusCollector>();
+    collector->setDbSession(&workerDbSession());
+    auto initilizeOut = collector->initialize(m_view.path.c_str());
+    if (initilizeOut.first != ngrt4n::RcSuccess) {
+      m_result->rc = initilizeOut.first;
+      m_result->errorMsg = QObject::tr("%1: %2").arg(m_view.name.c_str(), initilizeOut.second);
+      return;
+    }
+    // the collector is kept and destroyed by the main thread, and updated from any worker of the pool
+    collector->moveToThread(QCoreApplication::instance()->thread());
+    m_model->collector = std::move(collector);
+    m_model->path = m_view.path;
+    m_model->serviceCount = m_view.service_count;
+    m_model->fileModified = fileModified;
+    m_model->fileSize = fileSize;
+    m_model->contentHash = contentHash;
+    m_model->statusName = viewStatusName(m_view, m_model->collector->rootNode().name.toStdString()).c_str();
+    m_result->modelLoaded = true;
+  }
+
+private:
+  DboView m_view;
+  ViewModelT* m_model;
+  ViewCollectionResultT* m_result;
+};
+
+
+class ViewCollectionTask : public QRunnable
+{
+public:
+  ViewCollectionTask(const DboView& view,
+                     const SourceListT& sources,
+                     ViewModelT* model,
+                     SourceFetchLimiter* limiter,
+                     const ViewStatusMapT* viewStatuses,
+                     ViewCollectionResultT* result)
+    : m_view(view),
+      m_sources(sources),
+      m_model(model),
+      m_sourceFetchLimiter(limiter),
+      m_viewStatuses(viewStatuses),
+      m_result(result) { }
+
+  void run(void) override {
+    auto& dbSession = workerDbSession();
+    auto& collector = *m_model->collector;
+    collector.setDbSession(&dbSession);
+    collector.setSourceFetchLimiter(m_sourceFetchLimiter);
+    collector.setSources(m_sources);
+    collector.setViewStatuses(m_viewStatuses);
+    auto updateOut = collector.updateAllNodesStatus();
+    m_result->sourceIds = collector.sourceIds();
+    m_result->failedSources = collector.failedSources();
+    if (updateOut.first != ngrt4n::RcSuccess) {
+      m_result->rc = updateOut.first;
+      m_result->errorMsg = updateOut.second;
+      return;
+    }
+
+    m_result->rc = ngrt4n::RcSuccess;
+    m_result->platformStatus = collector.info();
+    m_result->rootNode = collector.rootNode();
+    m_result->statusTransitions = collector.takeStatusTransitions();
+  }
+
+private:
+  DboView m_view;
+  SourceListT m_sources;
+  ViewModelT* m_model;
+  SourceFetchLimiter* m_sourceFetchLimiter;
+  const ViewStatusMapT* m_viewStatuses;
+  ViewCollectionResultT* m_result;
+};
+
+
+void runCollector(int period, int workerCount, int maxFetchesPerSource, int writeQueueCapacity)
 {
   ngrt4n::initReportdLogger();
 
@@ -57,28 +258,174 @@ void runCollector(int period)
       .Name("realopinsight_probes_status_percent")
       .Help("Status of monitored platforms and related components")
       .Register(*registry);
+  auto& promWriteLatency = prometheus::BuildGauge()
+      .Name("realopinsight_status_write_latency_seconds")
+      .Help("Time the last collection cycle took to queue its platform statuses for writing")
+      .Register(*registry)
+      .Add({});
+  auto& promDbPool = prometheus::BuildGauge()
+      .Name("realopinsight_db_pool_connections")
+      .Help("Connections of the database connection pool, by state")
+      .Register(*registry);
+  auto& promDbPoolSize = promDbPool.Add({{"state", "total"}});
+  auto& promDbPoolInUse = promDbPool.Add({{"state", "in_use"}});
+  auto& promDbPoolPeakInUse = promDbPool.Add({{"state", "peak_in_use"}});
+  auto& promDbPoolWait = prometheus::BuildCounter()
+      .Name("realopinsight_db_pool_wait_seconds_total")
+      .Help("Cumulated time spent waiting for a free database connection")
+      .Register(*registry)
+      .Add({});
+  auto& promWriteQueueDepth = prometheus::BuildGauge()
+      .Name("realopinsight_db_write_queue_depth")
+      .Help("Database writes waiting in the write-behind queue")
+      .Register(*registry)
+      .Add({});
+  auto& promWriteFlushLatency = prometheus::BuildGauge()
+      .Name("realopinsight_db_write_flush_latency_seconds")
+      .Help("Time taken by the last flush of the write-behind queue")
+      .Register(*registry)
+      .Add({});
   promExposer.RegisterCollectable(registry);
 
+  PollingScheduler scheduler(period);
+  SourceFetchLimiter sourceFetchLimiter(maxFetchesPerSource);
+  QThreadPool workerPool;
+  workerPool.setMaxThreadCount(workerCount);
+  workerPool.setExpiryTimeout(-1);
+  DbSession dbSession;
+  WebBaseSettings dbSettings;
+  DbChangeListener changeListener(dbSettings.getDbType(), dbSettings.getDbConnectionName());
+  changeListener.start(0); // on SQLite, changes are checked once per cycle
+  DbWriteQueue writeQueue(writeQueueCapacity);
+  writeQueue.start();
+  std::map<std::string, ViewModelT> viewModels;
+  ViewStatusMapT viewStatuses; // root status of the views evaluated in this process, by status name
+  QHash<QString, int> lastNotifiedStatuses; // kept across cycles since notification writes are queued
+  StatusJournal statusJournal(SettingFactory::coreStatusJournalDir());
+  time_t lastRollupTime = 0;
+  quint64 collectionCycle = 0;
 
-  while(1) {
-    DbSession dbSession;
+  while (! shutdownRequested) {
+    ++collectionCycle;
     WebBaseSettings settings;
-    Notificator notificator;
+    Notificator notificator(&dbSession, &writeQueue, &lastNotifiedStatuses);
     ListofPlatformStatusT platformStatusList;
     NodeListT rootNodes;
     DbViewsT vlist;
+    SettingFactory pollingSettings;
+    SourceListT sources;
 
     platformStatusList.clear();
     rootNodes.clear();
+
+    // only the data changed by other processes since the last cycle are reloaded,
+    // the sessions of the worker threads follow the same invalidations
+    auto changes = changeListener.pollChanges(dbSession);
+    if (changes.contains(DbSession::CachedSources)) {
+      // dynamic views are built from the settings of their source
+      for (auto& model: viewModels) {
+        model.second.collector.reset();
+      }
+    }
     try {
       vlist = dbSession.listViews();
+      sources = dbSession.listSources(MonitorT::Any);
     } catch(const std::exception& ex) {
       std::cerr << ex.what() <<"\n";
     }
 
+    auto cycleStartTime = PollingScheduler::ClockT::now();
+    QSet<QString> activeViews;
     for (const auto& view: vlist) {
-      PlatformStatusCollector collector;
-      collector.setDbSession(&dbSession);
+      activeViews.insert(view.name.c_str());
+      scheduler.addView(view.name.c_str(), cycleStartTime);
+    }
+    scheduler.setDefaultInterval(period);
+    scheduler.setViewIntervals(pollingSettings.viewUpdateIntervals());
+    scheduler.setSourceIntervals(pollingSettings.sourceUpdateIntervals());
+    scheduler.retainViews(activeViews);
+    for (auto model = viewModels.begin(); model != viewModels.end(); ) {
+      if (activeViews.contains(model->first.c_str())) {
+        ++model;
+      } else {
+        viewStatuses.remove(model->second.statusName);
+        model = viewModels.erase(model);
+      }
+    }
+    auto dueViews = scheduler.dueViews(cycleStartTime);
+
+    std::vector<DboView> dueViewList;
+    for (const auto& view: vlist) {
+      if (dueViews.contains(view.name.c_str())) {
+        scheduler.markCollected(view.name.c_str(), cycleStartTime);
+        dueViewList.push_back(view);
+        viewModels[view.name]; // created here so that no insertion happens while workers are running
+      }
+    }
+
+    // every task fills its own slot, results are then handled sequentially in this thread
+    std::vector<ViewCollectionResultT> results(dueViewList.size());
+    for (size_t index = 0; index < dueViewList.size(); ++index) {
+      const auto& view = dueViewList[index];
+      workerPool.start(new ViewLoadingTask(view, &viewModels[view.name], &results[index]));
+    }
+    workerPool.waitForDone();
+
+    // new collectors resume from the journaled severities, rather than taking every node as seen for the first time
+    for (size_t index = 0; index < dueViewList.size(); ++index) {
+      const auto& view = dueViewList[index];
+      if (results[index].modelLoaded) {
+        viewModels[view.name].collector->setLastSeverities(statusJournal.lastSeverities(view.name.c_str()));
+      }
+    }
+
+    // views referenced by external services are evaluated in an earlier wave than the views referencing them,
+    // so that the latter read the status computed in this cycle from viewStatuses rather than from the database
+    QHash<QString, QString> viewNamesByStatusName;
+    QHash<QString, size_t> viewIndexes;
+    for (size_t index = 0; index < dueViewList.size(); ++index) {
+      const auto& model = viewModels[dueViewList[index].name];
+      if (model.collector) {
+        viewNamesByStatusName.insert(model.statusName, dueViewList[index].name.c_str());
+        viewIndexes.insert(dueViewList[index].name.c_str(), index);
+      }
+    }
+    ViewDependencyGraph viewDependencies;
+    for (auto viewIndex = viewIndexes.cbegin(); viewIndex != viewIndexes.cend(); ++viewIndex) {
+      QSet<QString> referencedViews;
+      for (const auto& externalView: viewModels[dueViewList[viewIndex.value()].name].collector->externalViews()) {
+        if (viewNamesByStatusName.contains(externalView)) {
+          referencedViews.insert(viewNamesByStatusName.value(externalView));
+        }
+      }
+      viewDependencies.addView(viewIndex.key(), referencedViews);
+    }
+
+    for (const auto& wave: viewDependencies.evaluationWaves()) {
+      for (const auto& viewName: wave) {
+        const auto index = viewIndexes.value(viewName);
+        auto& model = viewModels[dueViewList[index].name];
+        model.collector->setUpdateCycle(collectionCycle);
+        workerPool.start(new ViewCollectionTask(dueViewList[index], sources, &model, &sourceFetchLimiter, &viewStatuses, &results[index]));
+      }
+      workerPool.waitForDone();
+      for (const auto& viewName: wave) {
+        const auto index = viewIndexes.value(viewName);
+        const auto& statusName = viewModels[dueViewList[index].name].statusName;
+        if (results[index].rc == ngrt4n::RcSuccess) {
+          viewStatuses.insert(statusName, ViewStatusT{results[index].rootNode.sev, time(nullptr)});
+        } else {
+          viewStatuses.remove(statusName);
+        }
+      }
+    }
+
+    // a source shared by several views counts for one failure or success per cycle in the back-off
+    QSet<QString> polledSources;
+    QSet<QString> failedSources;
+    for (size_t index = 0; index < dueViewList.size(); ++index) {
+      const auto& view = dueViewList[index];
+      auto& result = results[index];
 
       auto& promStatusOverall = promMetrics.Add({{"scope", view.name}, {"status", "summary"}});
       auto& promStatusCritical = promMetrics.Add({{"scope", view.name}, {"status", "critical"}});
@@ -87,22 +434,12 @@ void runCollector(int period)
       auto& promStatusMinor = promMetrics.Add({{"scope", view.name}, {"status", "minor"}});
       auto& promStatusNormal = promMetrics.Add({{"scope", view.name}, {"status", "normal"}});
 
-      auto initilizeOut = collector.initialize(view.path.c_str());
-      if (initilizeOut.first != ngrt4n::RcSuccess) {
-        REPORTD_LOG("error", QObject::tr("%1: %2").arg(view.name.c_str(), initilizeOut.second).toStdString());
-        promStatusOverall.Set(ngrt4n::Unknown);
-        promStatusCritical.Set(-1);
-        promStatusUnknown.Set(-1);
-        promStatusMajor.Set(-1);
-        promStatusMinor.Set(-1);
-        promStatusNormal.Set(-1);
-        continue;
-      }
+      scheduler.setViewSources(view.name.c_str(), result.sourceIds);
+      polledSources.unite(result.sourceIds);
+      failedSources.unite(result.failedSources);
 
-      collector.loadDataSources();
-      auto updateOut = collector.updateAllNodesStatus();
-      if (updateOut.first != ngrt4n::RcSuccess) {
-        REPORTD_LOG("error", updateOut.second.toStdString());
+      if (result.rc != ngrt4n::RcSuccess) {
+        REPORTD_LOG("error", result.errorMsg.toStdString());
         promStatusOverall.Set(ngrt4n::Unknown);
         promStatusCritical.Set(-1);
         promStatusUnknown.Set(-1);
@@ -112,13 +449,11 @@ void runCollector(int period)
         continue;
       }
 
-      PlatformStatusT platformStatus = collector.info();
-      if (platformStatus.view_name != view.name && std::regex_match(view.name, std::regex("Source[0-9]:.+"))) {
-        platformStatus.view_name = view.name;
-      }
+      PlatformStatusT platformStatus = result.platformStatus;
+      platformStatus.view_name = viewStatusName(view, platformStatus.view_name);
       platformStatus.timestamp = time(nullptr); // now
       platformStatusList.push_back(platformStatus);
-      rootNodes[platformStatus.view_name.c_str()] = collector.rootNode();
+      rootNodes[platformStatus.view_name.c_str()] = result.rootNode;
       promStatusOverall.Set(platformStatus.status);
       promStatusCritical.Set(platformStatus.critical);
       promStatusUnknown.Set(platformStatus.unknown);
@@ -126,22 +461,67 @@ void runCollector(int period)
       promStatusMinor.Set(platformStatus.minor);
       promStatusNormal.Set(platformStatus.normal);
 
-      try {
-        dbSession.addPlatformStatus(platformStatus);
-      } catch(const std::exception& ex) {
-        REPORTD_LOG("error", std::string(ex.what()));
+      if (! statusJournal.append(view.name.c_str(), result.statusTransitions)) {
+        REPORTD_LOG("error", QObject::tr("Failed to journal status changes of view: %1").arg(view.name.c_str()));
+      }
+    }
+
+    for (const auto& sid: polledSources) {
+      if (failedSources.contains(sid)) {
+        scheduler.reportSourceFailure(sid);
+      } else {
+        scheduler.reportSourceSuccess(sid);
       }
     }
 
+    // the statuses are written behind by the writer thread, this only blocks while the queue is full
+    auto writeStartTime = PollingScheduler::ClockT::now();
+    writeQueue.addPlatformStatusList(platformStatusList);
+    promWriteLatency.Set(std::chrono::duration<double>(PollingScheduler::ClockT::now() - writeStartTime).count());
+
     // handle notifications if applicable
     if (settings.getNotificationType() != WebBaseSettings::NoNotification) {
       for (const auto& pfs : platformStatusList) {
         notificator.handleNotification(rootNodes[pfs.view_name.c_str()], pfs);
       }
     }
-    wait_for_interval(period);
+
+    // roll up the new samples and purge expired data at the pace of the finest rollup tier
+    if (time(nullptr) - lastRollupTime >= DbSession::STATUS_ROLLUP_RESOLUTIONS.front()) {
+      lastRollupTime = time(nullptr);
+      auto rollupOut = dbSession.updateStatusRollups();
+      if (rollupOut.first != ngrt4n::RcSuccess) {
+        REPORTD_LOG("error", rollupOut.second);
+      }
+      auto purgeOut = dbSession.purgeExpiredStatusData(statusRetentions(pollingSettings.statusRetentionDays()));
+      if (purgeOut.first != ngrt4n::RcSuccess) {
+        REPORTD_LOG("error", purgeOut.second);
+      }
+    }
+    if (dbSession.connectionPool()) {
+      auto poolStats = dbSession.connectionPool()->stats();
+      promDbPoolSize.Set(poolStats.size);
+      promDbPoolInUse.Set(poolStats.inUse);
+      promDbPoolPeakInUse.Set(poolStats.peakInUse);
+      // the pool reports a cumulated wait time, the counter only takes the increase since the last cycle
+      if (poolStats.waitSeconds > promDbPoolWait.Value()) {
+        promDbPoolWait.Increment(poolStats.waitSeconds - promDbPoolWait.Value());
+      }
+    }
+    auto writeQueueStats = writeQueue.stats();
+    promWriteQueueDepth.Set(writeQueueStats.depth);
+    promWriteFlushLatency.Set(writeQueueStats.lastFlushSeconds);
+
+    // sleeps by slices of at most one second so that shutdown requests are handled promptly
+    auto nextDeadline = scheduler.nextDeadline(PollingScheduler::ClockT::now());
+    for (auto now = PollingScheduler::ClockT::now(); ! shutdownRequested && now < nextDeadline; now = PollingScheduler::ClockT::now()) {
+      std::this_thread::sleep_for(std::min<PollingScheduler::ClockT::duration>(nextDeadline - now, std::chrono::seconds(1)));
+    }
   }
 
+  REPORTD_LOG("notice", QObject::tr("Shutting down, flushing pending database writes"));
+  writeQueue.stop();
+  changeListener.stop();
   ngrt4n::freeReportdLogger();
 }
 
@@ -150,15 +530,33 @@ int main(int argc, char **argv)
   RoiQApp qtApp(argc, argv);
 
   int period = 5;
+  int workerCount = 4;
+  int maxFetchesPerSource = 2;
+  int writeQueueCapacity = 10000;
   bool ok;
   int opt;
-  if ((opt = getopt(argc, argv, "t:dh")) != -1) {
+  while ((opt = getopt(argc, argv, "t:w:s:q:dh")) != -1) {
     switch (opt) {
       case 't':
         period = QString(optarg).toInt(&ok);
         if (! ok || period < 1)
           period = 1;
         break;
+      case 'w':
+        workerCount = QString(optarg).toInt(&ok);
+        if (! ok || workerCount < 1)
+          workerCount = 1;
+        break;
+      case 's':
+        maxFetchesPerSource = QString(optarg).toInt(&ok);
+        if (! ok || maxFetchesPerSource < 1)
+          maxFetchesPerSource = 1;
+        break;
+      case 'q':
+        writeQueueCapacity = QString(optarg).toInt(&ok);
+        if (! ok || writeQueueCapacity < 1)
+          writeQueueCapacity = 1;
+        break;
       case 'h':
         break;
       default:
@@ -170,7 +568,11 @@ int main(int argc, char **argv)
 
   REPORTD_LOG("notice", QObject::tr("Reporting collector started"));
   REPORTD_LOG("notice", QObject::tr(" => Interval: %1 second(s)").arg(QString::number(period)));
-  runCollector(period); // convert period in seconds
+  REPORTD_LOG("notice", QObject::tr(" => Workers: %1, concurrent fetches per source: %2").arg(QString::number(workerCount), QString::number(maxFetchesPerSource)));
+  REPORTD_LOG("notice", QObject::tr(" => Write queue capacity: %1").arg(QString::number(writeQueueCapacity)));
+  std::signal(SIGTERM, requestShutdown);
+  std::signal(SIGINT, requestShutdown);
+  runCollector(period, workerCount, maxFetchesPerSource, writeQueueCapacity); // convert period in seconds
 
-  return qtApp.exec();
+  return EXIT_SUCCESS;
 }
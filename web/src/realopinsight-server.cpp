@@ -26,9 +26,23 @@
 #include "AuthManager.hpp"
 #include "WebMainUI.hpp"
 #include "WebApplication.hpp"
+#include "DbChangeListener.hpp"
+#include "WebBaseSettings.hpp"
+#include "DbConnectionPool.hpp"
 #include "utils/wtwithqt/WQApplication.h"
 #include <QCoreApplication>
 #include <Wt/WServer.h>
+#include <prometheus/counter.h>
+#include <prometheus/gauge.h>
+#include <prometheus/exposer.h>
+#include <prometheus/registry.h>
+#include <atomic>
+#include <thread>
+
+
+const int CHANGE_POLL_INTERVAL = 5; // seconds, on SQLite
+const int DB_POOL_METRICS_INTERVAL = 5; // seconds
+const std::string METRICS_BIND_ADDRESS = "0.0.0.0:4585"; // reportd already exposes its metrics on 4584
 
 
 std::unique_ptr<Wt::WApplication> createRoiApplication(const Wt::WEnvironment& env)
@@ -37,6 +51,80 @@ std::unique_ptr<Wt::WApplication> createRoiApplication(const Wt::WEnvironment& e
 }
 
 
+/**
+ * @brief Exports the metrics of the database connection pool shared by the web sessions.
+ * The pool statistics are sampled by a background thread until stop() is called.
+ */
+class DbPoolMetricsExporter
+{
+public:
+  DbPoolMetricsExporter(DbConnectionPool& pool)
+    : m_pool(pool),
+      m_exposer(METRICS_BIND_ADDRESS),
+      m_registry(std::make_shared<prometheus::Registry>()),
+      m_connections(prometheus::BuildGauge()
+                    .Name("realopinsight_db_pool_connections")
+                    .Help("Connections of the database connection pool, by state")
+                    .Register(*m_registry)),
+      m_size(m_connections.Add({{"state", "total"}})),
+      m_inUse(m_connections.Add({{"state", "in_use"}})),
+      m_peakInUse(m_connections.Add({{"state", "peak_in_use"}})),
+      m_wait(prometheus::BuildCounter()
+             .Name("realopinsight_db_pool_wait_seconds_total")
+             .Help("Cumulated time spent waiting for a free database connection")
+             .Register(*m_registry)
+             .Add({})),
+      m_stopped(false)
+  {
+    m_exposer.RegisterCollectable(m_registry);
+  }
+
+  void start(int interval)
+  {
+    m_thread = std::thread([this, interval]() {
+      while (! m_stopped) {
+        update();
+        for (int elapsed = 0; elapsed < interval && ! m_stopped; ++elapsed) {
+          std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+      }
+    });
+  }
+
+  void stop(void)
+  {
+    m_stopped = true;
+    if (m_thread.joinable()) {
+      m_thread.join();
+    }
+  }
+
+private:
+  DbConnectionPool& m_pool;
+  prometheus::Exposer m_exposer;
+  std::shared_ptr<prometheus::Registry> m_registry;
+  prometheus::Family<prometheus::Gauge>& m_connections;
+  prometheus::Gauge& m_size;
+  prometheus::Gauge& m_inUse;
+  prometheus::Gauge& m_peakInUse;
+  prometheus::Counter& m_wait;
+  std::atomic<bool> m_stopped;
+  std::thread m_thread;
+
+  void update(void)
+  {
+    auto poolStats = m_pool.stats();
+    m_size.Set(poolStats.size);
+    m_inUse.Set(poolStats.inUse);
+    m_peakInUse.Set(poolStats.peakInUse);
+    // the pool reports a cumulated wait time, the counter only takes the increase since the last sample
+    if (poolStats.waitSeconds > m_wait.Value()) {
+      m_wait.Increment(poolStats.waitSeconds - m_wait.Value());
+    }
+  }
+};
+
+
 int main(int argc, char **argv)
 {
   RoiQApp qtApp (argc, argv);
@@ -48,7 +136,25 @@ int main(int argc, char **argv)
     server.addEntryPoint(Wt::EntryPointType::Application, createRoiApplication, "", "favicon.ico");
 
     if (server.start()) {
+      // keeps the caches of the web sessions in sync with the changes made by other processes
+      WebBaseSettings settings;
+      DbChangeListener changeListener(settings.getDbType(), settings.getDbConnectionName());
+      changeListener.start(CHANGE_POLL_INTERVAL);
+      // the pool is shared by all the web sessions of the process, see DbConnectionPool::instance
+      std::unique_ptr<DbPoolMetricsExporter> poolMetrics;
+      try {
+        poolMetrics = std::make_unique<DbPoolMetricsExporter>(DbConnectionPool::instance(settings.getDbType(),
+                                                                                         settings.getDbConnectionName(),
+                                                                                         settings.getDbConnectionPoolSize()));
+        poolMetrics->start(DB_POOL_METRICS_INTERVAL);
+      } catch (const std::exception& ex) {
+        CORE_LOG("error", QObject::tr("database pool metrics disabled: %1").arg(ex.what()).toStdString());
+      }
       Wt::WServer::waitForShutdown();
+      if (poolMetrics) {
+        poolMetrics->stop();
+      }
+      changeListener.stop();
       server.stop();
     }
   } catch (dbo::Exception& ex){
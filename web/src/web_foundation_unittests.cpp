@@ -1,6 +1,10 @@
 
 #include "web_foundation_unittests.hpp"
 #include "Base.hpp"
+#include "utilsCore.hpp"
+#include "WebTree.hpp"
+#include <Wt/WApplication.h>
+#include <Wt/Test/WTestEnvironment.h>
 
 namespace {
   const std::string TEST_USER1 = "test_user1";
@@ -74,4 +78,72 @@ void NotificationTest::testFlushNotification(void)
 	//FIXME: QCOMPARE(0, m_dbSession.countViewRelatedNotifications(TEST_VIEW1));
 }
 
-QTEST_MAIN(NotificationTest)
+
+namespace {
+  NodeT makeNode(const QString& id, qint32 type, const QString& parentId)
+  {
+    NodeT node;
+    node.id = node.name = id;
+    node.type = type;
+    node.sev = ngrt4n::Normal;
+    if (! parentId.isEmpty()) {
+      node.parents.insert(parentId);
+    }
+    return node;
+  }
+
+  Wt::WModelIndex findChildIndex(WebTree& tree, const Wt::WModelIndex& parent, const QString& nodeId)
+  {
+    auto model = tree.model();
+    for (int row = 0; row < model->rowCount(parent); ++row) {
+      auto index = model->index(row, 0, parent);
+      if (tree.findNodeIdFromTreeItem(index) == nodeId) {
+        return index;
+      }
+    }
+    return Wt::WModelIndex();
+  }
+}
+
+void WebTreeTest::testInsertNodeItemsIntoExistingTree(void)
+{
+  Wt::Test::WTestEnvironment env;
+  Wt::WApplication app(env);
+
+  CoreDataT cdata;
+  cdata.bpnodes.insert(ngrt4n::ROOT_ID, makeNode(ngrt4n::ROOT_ID, NodeType::BusinessService, ""));
+
+  WebTree tree(&cdata);
+  tree.build();
+
+  auto rootIndex = findChildIndex(tree, Wt::WModelIndex(), ngrt4n::ROOT_ID);
+  QVERIFY(rootIndex.isValid());
+  QCOMPARE(0, tree.model()->rowCount(rootIndex));
+
+  tree.insertNodeItem(makeNode("host1", NodeType::BusinessService, ngrt4n::ROOT_ID));
+  tree.insertNodeItem(makeNode("host1/cpu", NodeType::ITService, "host1"));
+
+  auto hostIndex = findChildIndex(tree, rootIndex, "host1");
+  QVERIFY(hostIndex.isValid());
+  QVERIFY(findChildIndex(tree, hostIndex, "host1/cpu").isValid());
+
+  // inserting an already known node must not duplicate it
+  tree.insertNodeItem(makeNode("host1", NodeType::BusinessService, ngrt4n::ROOT_ID));
+  QCOMPARE(1, tree.model()->rowCount(rootIndex));
+}
+
+
+int main(int argc, char** argv)
+{
+  QCoreApplication app(argc, argv);
+  int failures = 0;
+  {
+    NotificationTest test;
+    failures += QTest::qExec(&test, argc, argv);
+  }
+  {
+    WebTreeTest test;
+    failures += QTest::qExec(&test, argc, argv);
+  }
+  return failures;
+}
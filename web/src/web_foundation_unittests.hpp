@@ -22,3 +22,12 @@ private Q_SLOTS:
 private:
   DbSession m_dbSession;
 };
+
+
+class WebTreeTest : public QObject
+{
+  Q_OBJECT
+
+private Q_SLOTS:
+  void testInsertNodeItemsIntoExistingTree(void);
+};